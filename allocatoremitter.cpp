@@ -0,0 +1,72 @@
+#include "allocatoremitter.hpp"
+#include "dirtyemitter.hpp"
+
+#include <qregularexpression.h>
+
+QString AllocatorEmitter::annotation() {
+    return "pmr";
+}
+
+QString AllocatorEmitter::pmrType(const QString& type)
+{
+    static const QRegularExpression re("\\bstd::(w?string|vector|deque|list|(?:unordered_)?(?:multi)?(?:map|set))\\b");
+    QString result = type;
+    return result.replace(re, "std::pmr::\\1");
+}
+
+QString AllocatorEmitter::name() const {
+    return "allocator";
+}
+
+void AllocatorEmitter::emitStruct(const TypeDescriptor& type, TypeCode& code)
+{
+    if (!type.annotations.contains(annotation()) || type.members.isEmpty()) {
+        return;
+    }
+
+    QStringList params;
+    QStringList defaultInits;
+    QStringList copyInits;
+    QStringList moveInits;
+    QStringList sinkInits;
+
+    for (const MemberDescriptor& member: type.members) {
+        params << QString("%0 %1_").arg(member.type).arg(member.name);
+    }
+    for (int i: type.declarationOrder) {
+        const MemberDescriptor& member = type.members.at(i);
+        QString make = QString("%0(gbp::make_using_allocator<%1>(alloc%2))").arg(member.name).arg(member.type);
+        QString value = member.value.trimmed();
+        if (value.startsWith('{')) {
+            value = member.type + value;
+        }
+        defaultInits << make.arg(value.isEmpty() ? QString() : ", " + value);
+        copyInits << make.arg(", other." + member.name);
+        moveInits << make.arg(QString(", std::move(other.%0)").arg(member.name));
+        sinkInits << make.arg(QString(", std::move(%0_)").arg(member.name));
+    }
+    if (type.annotations.contains(DirtyEmitter::annotation())) {
+        copyInits << "m_dirty(other.m_dirty)";
+        moveInits << "m_dirty(other.m_dirty)";
+    }
+
+    code.operators += QString("// allocator-aware construction, members are built in the resource of alloc\n"
+                              "using allocator_type = std::pmr::polymorphic_allocator<char>;\n"
+                              "explicit %0(const allocator_type& alloc)\n"
+                              "    : %1\n"
+                              "{}\n"
+                              "%0(const %0& other, const allocator_type& alloc)\n"
+                              "    : %2\n"
+                              "{}\n"
+                              "%0(%0&& other, const allocator_type& alloc)\n"
+                              "    : %3\n"
+                              "{}\n"
+                              "%0(%4, const allocator_type& alloc)\n"
+                              "    : %5\n"
+                              "{}\n").arg(type.name)
+                                     .arg(defaultInits.join("\n    , "))
+                                     .arg(copyInits.join("\n    , "))
+                                     .arg(moveInits.join("\n    , "))
+                                     .arg(params.join(", "))
+                                     .arg(sinkInits.join("\n    , "));
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "emitter.hpp"
+
+/**
+ Allocator-aware types for the types tagged "pmr" in GeneratorConfig (gbp_alloc.hpp).
+ CodeGen declares their standard string and container members with the std::pmr aliases,
+ the types get allocator_type and allocator-extended default, copy, move and member-wise constructors,
+ so std::pmr containers of them, and the decoders filling those, construct them in the container's resource.
+ */
+class AllocatorEmitter : public Emitter
+{
+public:
+    static QString annotation();
+    /** the standard strings and containers of a member type replaced by their std::pmr aliases */
+    static QString pmrType(const QString& type);
+
+    virtual QString name() const override;
+
+    virtual void emitStruct(const TypeDescriptor& type, TypeCode& code) override;
+};
@@ -0,0 +1,96 @@
+#include "codecemitter.hpp"
+
+QString CodecEmitter::wireType(const MemberDescriptor& member)
+{
+    static const QStringList wires = QStringList() << "fixed" << "varint" << "zigzag" << "delta";
+
+    // the first wire tag wins, annotations in the declaration come before the config ones
+    for (const QString& annotation: member.annotations) {
+        if (annotation == "fixed") {
+            return QString();
+        }
+        if (wires.contains(annotation)) {
+            return "gbp::wire::" + annotation;
+        }
+    }
+    return QString();
+}
+
+QString CodecEmitter::name() const {
+    return "codec";
+}
+
+void CodecEmitter::emitStruct(const TypeDescriptor& type, TypeCode& code)
+{
+    QStringList writes;
+    QStringList reads;
+    QStringList wires;
+    bool annotated = false;
+
+    for (const MemberDescriptor& member: type.members) {
+        QString wire = wireType(member);
+        if (wire.isEmpty()) {
+            writes << QString("    gbp::codec::write(buf, %0);\n").arg(member.name);
+            reads << QString("gbp::codec::read(in, %0)").arg(member.name);
+            wires << "gbp::wire::fixed";
+        } else {
+            writes << QString("    gbp::codec::write_as<%1>(buf, %0);\n").arg(member.name).arg(wire);
+            reads << QString("gbp::codec::read_as<%1>(in, %0)").arg(member.name).arg(wire);
+            wires << wire;
+            annotated = true;
+        }
+    }
+    if (writes.isEmpty()) {
+        writes << "    (void)buf;\n";
+        reads << "((void)in, true)";
+    }
+
+    if (annotated) {
+        code.extra += QString("using wire_types = std::tuple<%0>;\n").arg(wires.join(", "));
+    }
+    code.extra += "void encode(gbp::buffer& buf) const;\n"
+                  "bool decode(gbp::reader& in);\n"
+                  "/** fails unless the whole input is consumed */\n"
+                  "inline bool decode(gbp::byte_span in) { gbp::reader r(in); return decode(r) && r.at_end(); }\n";
+
+    if (type.plain) {
+        // the memory image is the little endian encoding of the members
+        code.impl += additionalsOnly(QString("void %0::encode(gbp::buffer& buf) const {\n"
+                                             "#ifndef GBP_CODEC_BIG_ENDIAN\n"
+                                             "    buf.put(this, sizeof(%0));\n"
+                                             "#else\n"
+                                             "%1"
+                                             "#endif\n"
+                                             "}\n"
+                                             "bool %0::decode(gbp::reader& in) {\n"
+                                             "#ifndef GBP_CODEC_BIG_ENDIAN\n"
+                                             "    return in.read(this, sizeof(%0));\n"
+                                             "#else\n"
+                                             "    return %2;\n"
+                                             "#endif\n"
+                                             "}\n").arg(type.fullName).arg(writes.join("")).arg(reads.join("\n        && ")));
+        return;
+    }
+    code.impl += additionalsOnly(QString("void %0::encode(gbp::buffer& buf) const {\n"
+                                         "%1"
+                                         "}\n"
+                                         "bool %0::decode(gbp::reader& in) {\n"
+                                         "    return %2;\n"
+                                         "}\n").arg(type.fullName).arg(writes.join("")).arg(reads.join("\n        && ")));
+}
+
+void CodecEmitter::emitEnum(const TypeDescriptor& type, TypeCode& code)
+{
+    // simple enums have no fixed underlying type, they are written as 32 bit
+    QString underlying = type.kind == TypeDescriptor::Kind::EnumClass ? type.underlyingType : QString("gbp_i32");
+
+    code.related += additionalsOnly(QString("%9inline void encode(gbp::buffer& buf, %0 e) { gbp::codec::write_fixed(buf, static_cast<%1>(e)); }\n"
+                                            "%9inline bool decode(gbp::reader& in, %0& e) {\n"
+                                            "    %1 raw;\n"
+                                            "    if (!gbp::codec::read_fixed(in, raw)) {\n"
+                                            "        return false;\n"
+                                            "    }\n"
+                                            "    e = static_cast<%0>(raw);\n"
+                                            "    return true;\n"
+                                            "}\n").arg(type.fullName).arg(underlying).arg(type.friendPrefix()));
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "emitter.hpp"
+
+/**
+ Compact binary codec (gbp_codec.hpp).
+ Structs get encode(gbp::buffer&)/decode(gbp::reader&) writing the members in declaration order,
+ enums get free encode/decode functions that use the declared underlying type.
+ Members annotated with varint, zigzag, delta or fixed are written with that wire encoding.
+ */
+class CodecEmitter : public Emitter
+{
+public:
+    /** gbp::wire tag of the member, empty for the default encoding */
+    static QString wireType(const MemberDescriptor& member);
+
+    virtual QString name() const override;
+
+    virtual void emitStruct(const TypeDescriptor& type, TypeCode& code) override;
+    virtual void emitEnum(const TypeDescriptor& type, TypeCode& code) override;
+};
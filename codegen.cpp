@@ -1,8 +1,29 @@
 #include "codegen.hpp"
 #include "context.hpp"
 #include "contextmodel.hpp"
+#include "emitter.hpp"
+#include "generatorconfig.hpp"
+#include "allocatoremitter.hpp"
+#include "codecemitter.hpp"
+#include "columnsemitter.hpp"
+#include "dirtyemitter.hpp"
+#include "enumemitter.hpp"
+#include "externemitter.hpp"
+#include "hashemitter.hpp"
+#include "inlinestorage.hpp"
+#include "jsonemitter.hpp"
+#include "layoutemitter.hpp"
+#include "memberlayout.hpp"
+#include "metaemitter.hpp"
+#include "patchemitter.hpp"
+#include "poolemitter.hpp"
+#include "registryemitter.hpp"
+#include "schemaemitter.hpp"
+#include "viewemitter.hpp"
 
 #include <qdebug.h>
+#include <qhash.h>
+#include <qmap.h>
 #include <qregularexpression.h>
 
 namespace
@@ -25,25 +46,21 @@ namespace
         return QString("inline bool operator==(const %0& other) const { return %1; }\n").arg(classname).arg(memCompares.join(" && "));
     }
 
-    QString genMemberName(const QString& classname, const QStringList& memberNames) {
-        QStringList specMethods;
+    QString genMemberNames(const QStringList& memberNames) {
+        QStringList quoted;
 
-        for (int i = 0; i < memberNames.size(); i++) {
-            specMethods << QString("template <> const char* %1::member_name<%2>() { return \"%3\"; }").arg(classname).arg(i).arg(memberNames.at(i));
+        for (const QString& memberName: memberNames) {
+            quoted << QString("\"%0\"").arg(memberName);
         }
 
-        return specMethods.join("\n");
+        return QString("constexpr static const std::array<const char*, %0> member_names = {{%1}};\n").arg(memberNames.size()).arg(quoted.join(", "));
     }
 
-    QString genGetMember(const QString& classname, const QStringList& memberNames) {
-        QStringList specMethods;
-
-        for (int i = 0; i < memberNames.size(); i++) {
-            specMethods << QString("template <>       typename std::tuple_element<%2, %1::types_as_tuple>::type& %1::get_member<%2>()       { return %3; }").arg(classname).arg(i).arg(memberNames.at(i));
-            specMethods << QString("template <> const typename std::tuple_element<%2, %1::types_as_tuple>::type& %1::get_member<%2>() const { return %3; }").arg(classname).arg(i).arg(memberNames.at(i));
-        }
+    QString genGetMember(const QStringList& memberNames) {
+        QString tie = QString("std::tie(%0)").arg(memberNames.join(", "));
 
-        return specMethods.join("\n");
+        return QString("template <int N>       typename std::tuple_element<N, types_as_tuple>::type& get_member()       { return std::get<N>(%0); }\n"
+                       "template <int N> const typename std::tuple_element<N, types_as_tuple>::type& get_member() const { return std::get<N>(%0); }\n").arg(tie);
     }
 
 //    QString genApplyMethod(const QStringList& memberNames) {
@@ -78,53 +95,49 @@ namespace
     QString genSerialize(const QStringList& memberNames) {
         return QString("\ntemplate<typename Archive>\nvoid serialize(Archive &ar) { ar & %1; }\n").arg(memberNames.join(" & "));
     }
-    Code genOstreamOp(const QString& classname, const QStringList& memberNames) {
-        QStringList membersToOs;
-
-        for (const QString& memberName: memberNames) {
-            membersToOs << QString(R"os(
-os << "\"%0\":";
-std::quoting(os, obj.%0);)os").arg(memberName);
-        }
-
+    Code genOstreamOp(const QString& classname) {
         Code code;
         // %9 - friend if needed
         code.decl = QString("%9std::ostream& operator<<(std::ostream& os, const %0& obj);\n").arg(classname);
         code.impl = QString("std::ostream& operator<<(std::ostream& os, const %0& obj) {\n"
-                            "    os << '{';"
-                            "    %1\n"
-                            "    os << '}';\n"
-                            "    return os;\n"
-                            "}\n").arg(classname).arg(membersToOs.join("\nos << ',';\n"));
+                            "    gbp::json::writer w;\n"
+                            "    obj.to_json(w);\n"
+                            "    return os.write(w.data(), static_cast<std::streamsize>(w.size()));\n"
+                            "}\n").arg(classname);
         return code;
     }
 
-    Code genOstreamOpEnum(const QString& classname, const QStringList& memberNames) {
-//        QStringList membersToOs;
-        QStringList membersToEnumCast;
-
-        for (const QString& memberName: memberNames) {
-//            membersToOs << QString("case %0::%1: os << \"%1\"; break;").arg(classname).arg(memberName);
-            membersToEnumCast << QString("case %0::%1: return is_full_name ? \"%0::%1\" : \"%1\";").arg(classname).arg(memberName);
-        }
-
+    Code genOstreamOpEnum(const QString& classname) {
         Code code;
         // %9 - friend if needed
-        code.decl = QString("%9const char* enum_cast(%0 e, bool is_full_name = false);\n").arg(classname);
-        code.decl += QString("%9std::ostream& operator<<(std::ostream& os, %0 e);\n").arg(classname);
-        code.impl = QString("const char* enum_cast(%0 e, bool is_full_name) {\n"
-                            "    switch (e) {\n"
-                            "    %1\n"
-                            "    }\n"
-                            "    return \"\";\n"
-                            "}\n").arg(classname).arg(membersToEnumCast.join("\n"));
-        code.impl += QString("std::ostream& operator<<(std::ostream& os, %0 e) {\n"
+        code.decl = QString("%9std::ostream& operator<<(std::ostream& os, %0 e);\n").arg(classname);
+        code.impl = QString("std::ostream& operator<<(std::ostream& os, %0 e) {\n"
                             "    os << '\"' << enum_cast(e, true) << '\"';\n"
                             "    return os;\n"
                             "}\n").arg(classname);
         return code;
     }
 
+    /** every member as a sink parameter, moved into place; members are initialized in declaration order */
+    Code genSinkCtor(const TypeDescriptor& type) {
+        Code code;
+        if (type.members.isEmpty()) {
+            return code;
+        }
+        QStringList params;
+        QStringList inits;
+        for (const MemberDescriptor& member: type.members) {
+            params << QString("%0 %1_").arg(member.type).arg(member.name);
+        }
+        for (int i: type.declarationOrder) {
+            inits << QString("%0(std::move(%0_))").arg(type.members.at(i).name);
+        }
+        code.decl = QString("%0%1(%2)\n"
+                            "    : %3\n"
+                            "{}").arg(type.members.size() == 1 ? "explicit " : "").arg(type.name).arg(params.join(", ")).arg(inits.join("\n    , "));
+        return code;
+    }
+
     Code genDefaultCtor(const QString& classname, const QStringList& memberNames, const QString& fullName) {
         Code code;
         code.decl = QString("%0() = default;").arg(classname);
@@ -135,7 +148,6 @@ std::quoting(os, obj.%0);)os").arg(memberName);
 
 } //namespace
 
-constexpr static const char* codeTmpGuardsAdditional = "#ifdef GBP_DECLARE_TYPE_GEN_ADDITIONALS\n%0\n#endif //GBP_DECLARE_TYPE_GEN_ADDITIONALS\n";
 /**
  %0 - namespace name
  %1 - content
@@ -149,7 +161,7 @@ R"code(namespace %0
 /**
  %0 - struct name
  %1 - member declarations
- %2 - operators declarations
+ %2 - member-wise constructor and operators declarations, after the nested types they may use
  %3 - extra code
  %4 - default constructor
  %5 - overloads outside the class
@@ -161,8 +173,8 @@ R"code(struct %0
     %4
     %0(const %0&) = default;
     %0& operator=(const %0&) = default;
-    %0& operator=(%0&&) = default;
-    %0(%0&&) = default;
+    %0& operator=(%0&&) noexcept(gbp::nothrow_move<types_as_tuple>::assign) = default;
+    %0(%0&&) noexcept(gbp::nothrow_move<types_as_tuple>::construct) = default;
 
 
 
@@ -221,28 +233,110 @@ bool isStruct(gbp::Context* c) {
     return c && (c->type() == gbp::ContextType::DeclStruct || c->type() == gbp::ContextType::Struct);
 }
 
-gbp::Context* getMemTypeContext(gbp::Context* c)
+namespace
 {
-    Q_ASSERT(c->type() == gbp::ContextType::Member);
-    for (gbp::Context* child: c->children()) {
-        if (child->type() == gbp::ContextType::MemberType) {
-            return child;
+    /** serialize, member tuple, comparison and member access */
+    class ReflectionEmitter : public Emitter
+    {
+    public:
+        virtual QString name() const override {
+            return "reflection";
         }
-    }
-    return nullptr;
-}
+
+        virtual void emitStruct(const TypeDescriptor& type, TypeCode& code) override
+        {
+            code.operators += genSerialize(type.memberNames);
+
+            code.operators += QString("using type = %0;\n").arg(type.name);
+            code.operators += QString("using types_as_tuple = std::tuple<%0>;\n").arg(type.memberTypes.join(", "));
+            code.operators += QString("constexpr static const int member_count = %0;\n").arg(type.memberTypes.size());
+            code.operators += QString("constexpr static const bool plain_layout = %0;\n").arg(type.plain ? "true" : "false");
+            if (type.plain) {
+                code.extra += QString("inline bool operator==(const %0& other) const { return std::memcmp(this, &other, sizeof(%0)) == 0; }\n").arg(type.name);
+                code.related += QString("static_assert(std::is_trivially_copyable<%0>::value && std::has_unique_object_representations<%0>::value, \"%0 is not plain\");\n").arg(type.fullName);
+            } else {
+                code.extra += genEqOperator(type.name, type.memberNames);
+            }
+            code.extra += QString("inline bool operator!=(const %0& other) const { return !operator==(other); }\n").arg(type.name);
+
+            code.extra += genGetMember(type.memberNames);
+
+            code.extra += genMemberNames(type.memberNames);
+            code.extra += QString("template <int N> constexpr static const char* member_name() { return member_names[N]; }\n");
+        }
+    };
+
+    /** operator<< */
+    class StreamEmitter : public Emitter
+    {
+    public:
+        virtual QString name() const override {
+            return "stream";
+        }
+
+        virtual void emitStruct(const TypeDescriptor& type, TypeCode& code) override
+        {
+            Code ostreamOp = genOstreamOp(type.fullName);
+            code.related += ostreamOp.decl.arg(type.friendPrefix());
+            code.impl += ostreamOp.impl;
+        }
+
+        virtual void emitEnum(const TypeDescriptor& type, TypeCode& code) override
+        {
+            Code ostreamOp = genOstreamOpEnum(type.fullName);
+            code.related += ostreamOp.decl.arg(type.friendPrefix());
+            code.impl += ostreamOp.impl;
+        }
+    };
+} //namespace
 
 struct CodeGen::Impl
 {
     ContextModel* m_model;
     QModelIndex m_rootIndex;
     Code m_code;
+    CodeGen* m_source;
+    QList<Emitter*> m_emitters;
+    QHash<const gbp::Context*, Code> m_cache;
+    QMap<QString, Code> m_exports;
+    QStringList m_globals; // TypeCode::global of the types since the last namespace level declaration
+    MemberLayout m_layout;
+    GeneratorConfig m_config;
 
     Impl()
         : m_model(nullptr)
         , m_rootIndex()
         , m_code()
-    {}
+        , m_source(nullptr)
+        , m_emitters()
+        , m_cache()
+        , m_exports()
+        , m_globals()
+        , m_layout()
+        , m_config()
+    {
+        m_emitters << new ReflectionEmitter
+                   << new EnumEmitter
+                   << new JsonEmitter
+                   << new StreamEmitter
+                   << new CodecEmitter
+                   << new PatchEmitter
+                   << new DirtyEmitter
+                   << new AllocatorEmitter
+                   << new PoolEmitter
+                   << new LayoutEmitter
+                   << new ExternEmitter
+                   << new ViewEmitter
+                   << new HashEmitter
+                   << new ColumnsEmitter
+                   << new MetaEmitter
+                   << new RegistryEmitter
+                   << new SchemaEmitter;
+    }
+    ~Impl()
+    {
+        qDeleteAll(m_emitters);
+    }
 
     void disconnectFromModel(CodeGen* owner)
     {
@@ -253,7 +347,8 @@ struct CodeGen::Impl
     }
     void connectToModel(CodeGen* owner)
     {
-        if (m_model != nullptr) {
+        // a codegen fed from another one is regenerated by its source
+        if (m_model != nullptr && m_source == nullptr) {
             owner->connect(m_model, &ContextModel::modelReset, owner, &CodeGen::generateCode);
             owner->connect(m_model, &ContextModel::dataChanged, owner, &CodeGen::generateCode);
             owner->connect(m_model, &ContextModel::rowsInserted, owner, &CodeGen::generateCode);
@@ -262,7 +357,213 @@ struct CodeGen::Impl
         }
     }
 
+    Code generate(gbp::Context* root)
+    {
+        m_cache.clear();
+        m_exports.clear();
+        m_globals.clear();
+        m_layout.clear();
+
+        for (Emitter* emitter: m_emitters) {
+            emitter->begin();
+        }
+        Code code = contextToCode(root);
+        for (Emitter* emitter: m_emitters) {
+            Code exported = emitter->finish();
+            if (!exported.decl.isEmpty() || !exported.impl.isEmpty()) {
+                m_exports.insert(emitter->name(), exported);
+            }
+        }
+        return code;
+    }
+
+    TypeCode emitType(const TypeDescriptor& type)
+    {
+        TypeCode code;
+        for (Emitter* emitter: m_emitters) {
+            if (type.kind == TypeDescriptor::Kind::Struct) {
+                emitter->emitStruct(type, code);
+            } else {
+                emitter->emitEnum(type, code);
+            }
+        }
+        if (!code.global.isEmpty()) {
+            m_globals << code.global;
+        }
+        return code;
+    }
+
+    /**
+     appends the pending global code of the context and its nested types after its declaration,
+     leaving and reentering the enclosing namespaces; types nested into structs wait for the outermost one
+     */
+    QString flushGlobals(gbp::Context* context, const QString& decl)
+    {
+        if (m_globals.isEmpty() || isStruct(context->parent())) {
+            return decl;
+        }
+        QStringList namespaces;
+        for (gbp::Context* currContext = context->parent(); currContext; currContext = currContext->parent()) {
+            if (currContext->type() == gbp::ContextType::Namespace) {
+                namespaces.prepend(currContext->name());
+            }
+        }
+
+        QString code = decl + "\n";
+        for (int i = namespaces.size() - 1; i >= 0; i--) {
+            code += QString("} //namespace %0\n").arg(namespaces.at(i));
+        }
+        code += m_globals.join("\n");
+        for (const QString& name: namespaces) {
+            code += QString("namespace %0\n{\n").arg(name);
+        }
+        m_globals.clear();
+        return code;
+    }
+
+    /**
+     scope - qualified name of the struct, used to look the member up in the config
+     allocatorAware - the struct is tagged "pmr", its standard containers are declared with the std::pmr aliases
+     */
+    MemberDescriptor describeMember(gbp::Context* context, const QString& scope = QString(), bool allocatorAware = false)
+    {
+        Q_ASSERT(context->type() == gbp::ContextType::Member);
+        static const QRegularExpression annotationRe("^\\s*gbp:(.*)$", QRegularExpression::DotMatchesEverythingOption);
+
+        MemberDescriptor member;
+        member.name = context->name();
+
+        for (gbp::Context* child: context->children()) {
+            if (child->type() == gbp::ContextType::MemberType) {
+                member.type = contextToCode(child).decl.simplified();
+            } else if (child->type() == gbp::ContextType::MemberValue) {
+                member.value = contextToCode(child).decl;
+            } else if (child->type() == gbp::ContextType::Comment || child->type() == gbp::ContextType::LineComment) {
+                QRegularExpressionMatch match = annotationRe.match(child->content().toString());
+                if (match.hasMatch()) {
+                    member.annotations << match.captured(1).split(QRegularExpression("[\\s,]+"), QString::SkipEmptyParts);
+                }
+            } else {
+                Q_UNREACHABLE();
+            }
+        }
+        if (!scope.isEmpty()) {
+            member.annotations << m_config.memberAnnotations(scope + "::" + member.name);
+        }
+        int capacity = InlineStorage::capacity(member.annotations);
+        if (capacity > 0) {
+            QString inlineType = InlineStorage::inlineType(member.type, capacity);
+            if (inlineType == member.type) {
+                qWarning() << "no inline storage for" << member.type << "of" << scope + "::" + member.name;
+            }
+            member.type = inlineType;
+        }
+        if (allocatorAware) {
+            member.type = AllocatorEmitter::pmrType(member.type);
+        }
+
+        QString memVal = member.value.isEmpty() ? QString("{};") : "{" + member.value + "};";
+        member.decl = QString(codeTmpDeclMember).arg(member.name).arg(member.type).arg(memVal).simplified();
+        return member;
+    }
+
+    /** the members in declaration order are written as is by the codec: no dirty mask, no variable width wire */
+    bool isPlain(const TypeDescriptor& type) const
+    {
+        if (type.annotations.contains(DirtyEmitter::annotation())) {
+            return false;
+        }
+        QStringList emittedTypes;
+        for (int i = 0; i < type.declarationOrder.size(); i++) {
+            if (type.declarationOrder.at(i) != i) {
+                return false;
+            }
+            const MemberDescriptor& member = type.members.at(i);
+            QString wire = CodecEmitter::wireType(member);
+            if (!wire.isEmpty() && wire != "gbp::wire::fixed") {
+                return false;
+            }
+            emittedTypes << member.type;
+        }
+        return m_layout.isPlain(emittedTypes, type.qualifiedName);
+    }
+
+    TypeDescriptor describe(gbp::Context* context)
+    {
+        TypeDescriptor type;
+        type.name = context->name();
+        type.fullName = context->name();
+        type.nested = isStruct(context->parent());
+
+        for (gbp::Context* currContext = context; isStruct(currContext->parent()); currContext = currContext->parent()) {
+            type.fullName = currContext->parent()->name() + "::" + type.fullName;
+        }
+        for (gbp::Context* currContext = context->parent(); currContext; currContext = currContext->parent()) {
+            if (currContext->type() == gbp::ContextType::Namespace) {
+                type.namespaces.prepend(currContext->name());
+            }
+        }
+        type.qualifiedName = type.namespaces.isEmpty() ? type.fullName : type.namespaces.join("::") + "::" + type.fullName;
+        type.annotations = m_config.typeAnnotations(type.qualifiedName);
+
+        switch (context->type()) {
+        case gbp::ContextType::DeclStruct:
+            type.kind = TypeDescriptor::Kind::Struct;
+            for (gbp::Context* child: context->children()) {
+                if (child->type() == gbp::ContextType::Member) {
+                    type.members << describeMember(child, type.qualifiedName, type.annotations.contains(AllocatorEmitter::annotation()));
+                    type.memberNames << type.members.last().name;
+                    type.memberTypes << type.members.last().type;
+                    // described here rather than by contextToCode(), keep them for codeFor()
+                    m_cache.insert(child, Code(type.members.last().decl));
+                }
+            }
+            if (type.annotations.contains(MemberLayout::annotation())) {
+                type.declarationOrder = m_layout.packedOrder(type.memberTypes, type.qualifiedName);
+            } else {
+                for (int i = 0; i < type.members.size(); i++) {
+                    type.declarationOrder << i;
+                }
+            }
+            type.plain = isPlain(type);
+            break;
+        case gbp::ContextType::Enum:
+        case gbp::ContextType::EnumClass:
+        {
+            static const QRegularExpression re("(.+) *=");
+
+            type.kind = context->type() == gbp::ContextType::Enum ? TypeDescriptor::Kind::Enum : TypeDescriptor::Kind::EnumClass;
+            if (type.kind == TypeDescriptor::Kind::EnumClass) {
+                type.underlyingType = "gbp_u8";
+            }
+            for (gbp::Context* child: context->children()) {
+                if (child->type() == gbp::ContextType::EnumItem) {
+                    type.enumItemsDecl << contextToCode(child).decl;
+                    QStringList capt = re.match(type.enumItemsDecl.last()).capturedTexts();
+                    type.enumItems << (capt.size() > 1 ? capt.at(1) : type.enumItemsDecl.last()).trimmed();
+                } else if (child->type() == gbp::ContextType::UnderlyingType) {
+                    type.underlyingType = contextToCode(child).decl.trimmed();
+                }
+            }
+            MemberLayout::Layout layout = type.kind == TypeDescriptor::Kind::EnumClass ? m_layout.typeLayout(type.underlyingType, type.qualifiedName.section("::", 0, -2)) : MemberLayout::Layout(4, 4);
+            layout.plain = true;
+            m_layout.addType(type.qualifiedName, layout);
+            break;
+        }
+        default:
+            Q_UNREACHABLE();
+        }
+        return type;
+    }
+
     Code contextToCode(gbp::Context* context)
+    {
+        Code code = contextToCodeImpl(context);
+        m_cache.insert(context, code);
+        return code;
+    }
+
+    Code contextToCodeImpl(gbp::Context* context)
     {
         if (!context->hasConvertibleSymbols()) {
             return Code();
@@ -309,7 +610,16 @@ struct CodeGen::Impl
             for (gbp::Context* child: context->children()) {
                 if (!child->content().isEmpty())
                 {
-                    childrenContentsAsIs << "(" + child->content().toString() + ")";
+                    // the macro name goes together with its arguments, generated code may mention it (GBP_DECLARE_TYPE_GEN_ADDITIONALS)
+                    QString macro;
+                    switch (child->type()) {
+                    case gbp::ContextType::DeclStruct: macro = "GBP_DECLARE_TYPE";        break;
+                    case gbp::ContextType::EnumClass:  macro = "GBP_DECLARE_ENUM";        break;
+                    case gbp::ContextType::Enum:       macro = "GBP_DECLARE_ENUM_SIMPLE"; break;
+                    default:
+                        break;
+                    }
+                    childrenContentsAsIs << macro + "(" + child->content().toString() + ")";
                     Code code = contextToCode(child);
                     childrenContentsDecl << code.decl;
                     childrenContentsImpl << code.impl;
@@ -318,27 +628,17 @@ struct CodeGen::Impl
             for (int i = 0; i < childrenContentsAsIs.size(); i++) {
                 content.replace(childrenContentsAsIs.at(i), childrenContentsDecl.at(i));
             }
-            content.remove("GBP_DECLARE_TYPE").remove("GBP_DECLARE_ENUM").remove("GBP_DECLARE_ENUM_SIMPLE");
 
-            return Code(QString("struct %0;").arg(content), childrenContentsImpl.join("\n"));
+            return Code(flushGlobals(context, QString("struct %0;").arg(content)), childrenContentsImpl.join("\n"));
         }
         case gbp::ContextType::DeclStruct:
         {
             QStringList structsDecl;
             QStringList structsImpl;
             QStringList members;
-            QString operators;
-            QString extra;
-
-            QStringList memberTypes;
-            QStringList memberNames;
 
             for (gbp::Context* child: context->children()) {
-                if (child->type() == gbp::ContextType::Member) {
-                    members << contextToCode(child).decl;
-                    memberTypes << contextToCode(getMemTypeContext(child)).decl;
-                    memberNames << child->name();
-                } else if (child->type() == gbp::ContextType::DeclStruct || child->type() == gbp::ContextType::Enum || child->type() == gbp::ContextType::EnumClass) {
+                if (child->type() == gbp::ContextType::DeclStruct || child->type() == gbp::ContextType::Enum || child->type() == gbp::ContextType::EnumClass) {
                     auto code = contextToCode(child);
                     if (!code.decl.isEmpty()) {
                         structsDecl << code.decl;
@@ -349,129 +649,53 @@ struct CodeGen::Impl
                 }
             }
 
-            operators += genSerialize(memberNames);
-
-            operators += QString("using type = %0;\n").arg(context->name());
-            operators += QString("using types_as_tuple = std::tuple<%0>;\n").arg(memberTypes.join(", "));
-            operators += QString("constexpr static const int member_count = %0;").arg(memberTypes.size());
-            extra += genEqOperator(context->name(), memberNames);
-            extra += QString("inline bool operator!=(const %0& other) const { return !operator==(other); }\n").arg(context->name());
-
-            extra += QString("template <int N> typename std::tuple_element<N, types_as_tuple>::type& get_member();\n");
-            extra += QString("template <int N> const typename std::tuple_element<N, types_as_tuple>::type& get_member() const;\n");
-
-            extra += QString("template <int N> static const char* member_name();\n");
-
-//            extra += genApplyMethod(memberNames);
-//            extra += genCompareMethod(context->name(), memberNames);
-
-            QString getMemberImpl = genMemberName(context->name(), memberNames);
-            getMemberImpl += "\n" + genGetMember(context->name(), memberNames);
-//            static QString genOutsideUpper;
-
-//            if (!genOutsideUpper.isEmpty()) {
-//                genOutside += genOutsideUpper;
-//                genOutsideUpper = "";
-//            }
-
-            QString fullName = context->name();
-            for (gbp::Context* currContext = context; isStruct(currContext->parent()); currContext = currContext->parent())
-            {
-                getMemberImpl = getMemberImpl.replace(currContext->name() + "::", currContext->parent()->name() + "::" + currContext->name() + "::");
-                fullName = currContext->parent()->name() + "::" + fullName;
+            TypeDescriptor type = describe(context);
+            QStringList emittedTypes;
+            for (int i: type.declarationOrder) {
+                members << type.members.at(i).decl;
+                emittedTypes << type.members.at(i).type;
             }
-
-            Code ostreamOp = genOstreamOp(fullName, memberNames);
-            Code ctor = genDefaultCtor(context->name(), memberNames, fullName);
-
-            return Code(formatString(codeTmpStruct
-                               , context->name()
-                               , structsDecl.join('\n') + "\n" + members.join('\n')
-                               , operators
-                               , extra
-                               , ctor.decl
-                               , ostreamOp.decl.arg(context->parent()->type() == gbp::ContextType::DeclStruct ? "friend " : ""))
-                       , ctor.impl + "\n" + QString(codeTmpGuardsAdditional).arg(getMemberImpl) + "\n" + structsImpl.join("\n") + ostreamOp.impl);
+            MemberLayout::Layout layout = m_layout.structLayout(emittedTypes, type.qualifiedName);
+            layout.plain = type.plain;
+            m_layout.addType(type.qualifiedName, layout);
+            TypeCode typeCode = emitType(type);
+            Code ctor = genDefaultCtor(type.name, type.memberNames, type.fullName);
+            Code sinkCtor = genSinkCtor(type);
+
+            return Code(flushGlobals(context, formatString(codeTmpStruct
+                                                   , type.name
+                                                   , structsDecl.join('\n') + "\n" + members.join('\n')
+                                                   , sinkCtor.decl.isEmpty() ? typeCode.operators : sinkCtor.decl + "\n" + typeCode.operators
+                                                   , typeCode.extra
+                                                   , ctor.decl
+                                                   , typeCode.related))
+                       , ctor.impl + "\n" + structsImpl.join("\n") + typeCode.impl);
         }
         case gbp::ContextType::Enum:
         {
-            QStringList membersDecl;
-            QStringList members;
-            static const QRegularExpression re("(.+) *=");
-
-            for (gbp::Context* child: context->children()) {
-                if (child->type() == gbp::ContextType::EnumItem) {
-                    membersDecl << contextToCode(child).decl;
-                    QStringList capt = re.match(membersDecl.last()).capturedTexts();
-                    if (capt.size() > 1) {
-                        members << capt.at(1);
-                    } else {
-                        members << membersDecl.last();
-                    }
-                }
-            }
-
-            QString fullName = context->name();
-            for (gbp::Context* currContext = context;
-                 currContext->parent() && currContext->parent()->type() == gbp::ContextType::DeclStruct;
-                 currContext = currContext->parent())
-            {
-                fullName = currContext->parent()->name() + "::" + fullName;
-            }
-
-            Code ostreamOp = genOstreamOpEnum(fullName, members);
-
-            return Code(formatString(codeTmpSimpleEnum
-                                   , context->name()
-                                   , membersDecl.join(",\n")
-                                   , ostreamOp.decl.arg(isStruct(context->parent()) ? "friend " : ""))
-                    , ostreamOp.impl);
+            TypeDescriptor type = describe(context);
+            TypeCode typeCode = emitType(type);
+
+            return Code(flushGlobals(context, formatString(codeTmpSimpleEnum
+                                                       , type.name
+                                                       , type.enumItemsDecl.join(",\n")
+                                                       , typeCode.related))
+                    , typeCode.impl);
         }
         case gbp::ContextType::EnumClass:
         {
-            QString underlyingType("gbp_u8");
-            QStringList members;
-
-            for (gbp::Context* child: context->children()) {
-                if (child->type() == gbp::ContextType::EnumItem) {
-                    members << contextToCode(child).decl;
-                } else if (child->type() == gbp::ContextType::UnderlyingType) {
-                    underlyingType = child->content().toString();
-                }
-            }
-
-            QString fullName = context->name();
-            for (gbp::Context* currContext = context; isStruct(currContext->parent()); currContext = currContext->parent())
-            {
-                fullName = currContext->parent()->name() + "::" + fullName;
-            }
-
-            Code ostreamOp = genOstreamOpEnum(fullName, members);
-
-            return Code(formatString(codeTmpEnumClass
-                                   , context->name()
-                                   , underlyingType
-                                   , members.join(",\n")
-                                   , ostreamOp.decl.arg(isStruct(context->parent()) ? "friend " : ""))
-                    , ostreamOp.impl);
+            TypeDescriptor type = describe(context);
+            TypeCode typeCode = emitType(type);
+
+            return Code(flushGlobals(context, formatString(codeTmpEnumClass
+                                                       , type.name
+                                                       , type.underlyingType
+                                                       , type.enumItemsDecl.join(",\n")
+                                                       , typeCode.related))
+                    , typeCode.impl);
         }
         case gbp::ContextType::Member:
-        {
-            QString memType;
-            QString memVal("{};");
-
-            for (gbp::Context* child: context->children()) {
-                if (child->type() == gbp::ContextType::MemberType) {
-                    memType = contextToCode(child).decl;
-                } else if (child->type() == gbp::ContextType::MemberValue) {
-                    memVal = "{" + contextToCode(child).decl + "};";
-                } else {
-                    Q_UNREACHABLE();
-                }
-            }
-
-            return QString(codeTmpDeclMember).arg(context->name()).arg(memType).arg(memVal).simplified();
-        }
+            return describeMember(context).decl;
         case gbp::ContextType::EnumItem:
             return context->content().toString().replace(",", "=");
         case gbp::ContextType::UnderlyingType:
@@ -535,19 +759,78 @@ const Code& CodeGen::code() const {
     return m_impl->m_code;
 }
 
+void CodeGen::setSource(CodeGen* source)
+{
+    if (m_impl->m_source != source)
+    {
+        if (m_impl->m_source != nullptr) {
+            disconnect(m_impl->m_source, &CodeGen::codeGenerated, this, &CodeGen::generateCode);
+        }
+        m_impl->disconnectFromModel(this);
+        m_impl->m_source = source;
+        m_impl->connectToModel(this);
+        if (m_impl->m_source != nullptr) {
+            connect(m_impl->m_source, &CodeGen::codeGenerated, this, &CodeGen::generateCode);
+        }
+
+        generateCode();
+    }
+}
+
+CodeGen* CodeGen::source() const {
+    return m_impl->m_source;
+}
+
+Code CodeGen::codeFor(const gbp::Context* context) const {
+    return m_impl->m_cache.value(context);
+}
+
+void CodeGen::addEmitter(Emitter* emitter)
+{
+    Q_ASSERT(emitter != nullptr);
+    m_impl->m_emitters << emitter;
+    generateCode();
+}
+
+void CodeGen::setConfig(const GeneratorConfig& config)
+{
+    m_impl->m_config = config;
+    generateCode();
+}
+
+const GeneratorConfig& CodeGen::config() const {
+    return m_impl->m_config;
+}
+
+QStringList CodeGen::exportNames() const {
+    return m_impl->m_exports.keys();
+}
+
+Code CodeGen::exportedCode(const QString& emitterName) const {
+    return m_impl->m_exports.value(emitterName);
+}
+
 
 void CodeGen::generateCode()
 {
     Code newCode;
 
-    if (m_impl->m_model)
+    if (m_impl->m_source)
+    {
+        if (!rootIndex().isValid()) {
+            newCode = m_impl->m_source->code();
+        } else if (gbp::Context* context = m_impl->m_model ? m_impl->m_model->contextForIndex(rootIndex()) : nullptr) {
+            newCode = m_impl->m_source->codeFor(context);
+        }
+    }
+    else if (m_impl->m_model)
     {
         if (rootIndex().isValid()) {
             if (gbp::Context* context = m_impl->m_model->contextForIndex(rootIndex())) {
-                newCode = m_impl->contextToCode(context);
+                newCode = m_impl->generate(context);
             }
         } else if (gbp::Context* context = m_impl->m_model->context()) {
-            newCode = m_impl->contextToCode(context);
+            newCode = m_impl->generate(context);
         }
     }
 
@@ -561,4 +844,5 @@ void CodeGen::generateCode()
         m_impl->m_code.impl = newCode.impl;
         emit implCodeChanged(newCode.impl);
     }
+    emit codeGenerated();
 }
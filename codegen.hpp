@@ -1,8 +1,15 @@
 #pragma once
 
 #include <qobject.h>
+#include <qstringlist.h>
 
 class ContextModel;
+class Emitter;
+class GeneratorConfig;
+
+namespace gbp {
+    class Context;
+} //namespace gbp
 
 struct Code {
     QString decl;
@@ -38,6 +45,7 @@ private:
 signals:
     void declCodeChanged(const QString&);
     void implCodeChanged(const QString&);
+    void codeGenerated();
 public:
     CodeGen(QObject *parent = nullptr);
     virtual ~CodeGen() override;
@@ -49,6 +57,19 @@ public:
     QModelIndex rootIndex() const;
 
     const Code& code() const;
+
+    /** reuse the traversal of another codegen instead of walking the tree again (fragment previews) */
+    void setSource(CodeGen* source);
+    CodeGen* source() const;
+    Code codeFor(const gbp::Context* context) const;
+
+    void setConfig(const GeneratorConfig& config);
+    const GeneratorConfig& config() const;
+
+    /** takes ownership */
+    void addEmitter(Emitter* emitter);
+    QStringList exportNames() const;
+    Code exportedCode(const QString& emitterName) const;
 private slots:
     void generateCode();
 };
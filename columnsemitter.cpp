@@ -0,0 +1,62 @@
+#include "columnsemitter.hpp"
+
+/**
+ %0 - struct name, qualified with the enclosing structs
+ %1 - struct name
+ %2 - row accessors
+ %3 - column accessors
+ */
+constexpr static const char* codeTmpColumns =
+R"code(class %1Columns : public gbp::columns<%0>
+{
+public:
+    /** one row, the accessors refer into the columns of the owner */
+    template <typename Owner>
+    class basic_row
+    {
+        Owner* m_owner;
+        std::size_t m_index;
+    public:
+        basic_row(Owner* owner, std::size_t index) : m_owner(owner), m_index(index) {}
+
+        inline std::size_t index() const { return m_index; }
+        inline operator %0() const { return m_owner->get(m_index); }
+
+        %2
+    };
+    using row = basic_row<%1Columns>;
+    using const_row = basic_row<const %1Columns>;
+
+    inline row operator[](std::size_t i) { return row(this, i); }
+    inline const_row operator[](std::size_t i) const { return const_row(this, i); }
+
+    %3
+};
+)code";
+
+QString ColumnsEmitter::annotation() {
+    return "columns";
+}
+
+QString ColumnsEmitter::name() const {
+    return "columns";
+}
+
+void ColumnsEmitter::emitStruct(const TypeDescriptor& type, TypeCode& code)
+{
+    if (!type.annotations.contains(annotation()) || type.members.isEmpty()) {
+        return;
+    }
+
+    QStringList rowAccessors;
+    QStringList columnAccessors;
+
+    for (int i = 0; i < type.members.size(); i++) {
+        const QString& name = type.members.at(i).name;
+        rowAccessors << QString("inline decltype(auto) %0() const { return m_owner->%0()[m_index]; }").arg(name);
+        columnAccessors << QString("inline column_type<%1>& %0() { return column<%1>(); }\n"
+                                   "inline const column_type<%1>& %0() const { return column<%1>(); }").arg(name).arg(i);
+    }
+
+    code.related += additionalsOnly(QString(codeTmpColumns).arg(type.fullName).arg(type.name).arg(rowAccessors.join("\n")).arg(columnAccessors.join("\n")));
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "emitter.hpp"
+
+/**
+ Structure of arrays containers for types tagged "columns" in GeneratorConfig (gbp_columns.hpp).
+ <Type>Columns keeps one std::vector per member, with a named accessor per column,
+ row proxies referring into the columns and apply_columns() visiting them in member order.
+ */
+class ColumnsEmitter : public Emitter
+{
+public:
+    static QString annotation();
+
+    virtual QString name() const override;
+
+    virtual void emitStruct(const TypeDescriptor& type, TypeCode& code) override;
+};
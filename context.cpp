@@ -283,10 +283,13 @@ namespace gbp
         if (current == ContextType::Member)
         {
             if (ref.endsWith("(")) {
-                if (currentContext->children().empty()) {
-                    return ContextType::MemberType;
+                // comments (annotations) may come before the type
+                for (Context* child: currentContext->children()) {
+                    if (child->type() == ContextType::MemberType) {
+                        return ContextType::MemberValue;
+                    }
                 }
-                return ContextType::MemberValue;
+                return ContextType::MemberType;
             }
             return ContextType::None;
         }
@@ -0,0 +1,50 @@
+#include "dirtyemitter.hpp"
+#include "codecemitter.hpp"
+
+QString DirtyEmitter::annotation() {
+    return "dirty";
+}
+
+QString DirtyEmitter::name() const {
+    return "dirty";
+}
+
+void DirtyEmitter::emitStruct(const TypeDescriptor& type, TypeCode& code)
+{
+    if (!type.annotations.contains(annotation())) {
+        return;
+    }
+
+    QStringList setters;
+    QStringList writes;
+
+    for (int i = 0; i < type.members.size(); i++) {
+        const MemberDescriptor& member = type.members.at(i);
+        QString wire = CodecEmitter::wireType(member);
+        if (wire.isEmpty()) {
+            wire = "gbp::wire::fixed";
+        }
+        setters << QString("inline void set_%0(const %1& value) { %0 = value; m_dirty.set(%2, true); }\n"
+                           "inline void set_%0(%1&& value) { %0 = std::move(value); m_dirty.set(%2, true); }\n").arg(member.name).arg(member.type).arg(i);
+        writes << QString("    if (m_dirty.test(%0)) {\n"
+                          "        gbp::codec::write_whole<%2>(buf, %1);\n"
+                          "    }\n").arg(i).arg(member.name).arg(wire);
+    }
+
+    // the mask is declared unconditionally, the layout must not depend on GBP_DECLARE_TYPE_GEN_ADDITIONALS
+    code.operators += QString("// dirty tracking\n"
+                              "%0"
+                              "inline const gbp::patch_mask<member_count>& dirty_mask() const { return m_dirty; }\n"
+                              "inline void clear_dirty() { m_dirty = gbp::patch_mask<member_count>(); }\n"
+                              "private:\n"
+                              "gbp::patch_mask<member_count> m_dirty;\n"
+                              "public:\n").arg(setters.join(""));
+
+    code.extra += "/** the members touched through the setters since clear_dirty(), as a patch */\n"
+                  "void encode_dirty(gbp::buffer& buf) const;\n";
+
+    code.impl += additionalsOnly(QString("void %0::encode_dirty(gbp::buffer& buf) const {\n"
+                                         "    m_dirty.write(buf);\n"
+                                         "%1"
+                                         "}\n").arg(type.fullName).arg(writes.join("")));
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "emitter.hpp"
+
+/**
+ Dirty tracking for types tagged "dirty" in GeneratorConfig (gbp_patch.hpp).
+ Every member gets set_<name>() recording bit N of the member index used by get_member<N>(),
+ encode_dirty() writes the touched members as a patch that apply_patch() reads,
+ without a snapshot copy or a comparison pass. Direct writes to the members are not tracked.
+ */
+class DirtyEmitter : public Emitter
+{
+public:
+    static QString annotation();
+
+    virtual QString name() const override;
+
+    virtual void emitStruct(const TypeDescriptor& type, TypeCode& code) override;
+};
@@ -0,0 +1,35 @@
+#include "emitter.hpp"
+
+constexpr static const char* codeTmpGuardsAdditional = "#ifdef GBP_DECLARE_TYPE_GEN_ADDITIONALS\n%0\n#endif //GBP_DECLARE_TYPE_GEN_ADDITIONALS\n";
+
+Emitter::~Emitter()
+{}
+
+void Emitter::begin()
+{}
+
+void Emitter::emitStruct(const TypeDescriptor& /*type*/, TypeCode& /*code*/)
+{}
+
+void Emitter::emitEnum(const TypeDescriptor& /*type*/, TypeCode& /*code*/)
+{}
+
+Code Emitter::finish() {
+    return Code();
+}
+
+QString Emitter::additionalsOnly(const QString& code) {
+    return QString(codeTmpGuardsAdditional).arg(code);
+}
+
+QString Emitter::indented(const QString& code, int depth)
+{
+    QString prefix(depth * 4, ' ');
+    QStringList lines = code.split('\n');
+    for (QString& line: lines) {
+        if (!line.isEmpty()) {
+            line.prepend(prefix);
+        }
+    }
+    return lines.join('\n');
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <qstring.h>
+#include <qstringlist.h>
+#include <QVector>
+
+#include "codegen.hpp"
+
+struct MemberDescriptor {
+    QString name;
+    QString type;
+    QString value;  // default value as written in GBP_DECLARE_TYPE, empty if none
+    QString decl;   // ready to paste member declaration
+    QStringList annotations; // /*gbp: ...*/ tags inside the member declaration, then the ones from GeneratorConfig
+};
+
+/**
+ Everything the backends need to know about one GBP_DECLARE_* type.
+ Computed once per traversal by CodeGen and shared by all registered emitters.
+ */
+struct TypeDescriptor {
+    enum class Kind {
+        Struct,
+        Enum,
+        EnumClass
+    };
+
+    Kind kind;
+    QString name;           // as declared
+    QString fullName;       // qualified with the enclosing structs, valid inside the enclosing namespace
+    QString qualifiedName;  // qualified with namespaces and enclosing structs, without leading "::"
+    QStringList namespaces; // enclosing namespaces, outermost first
+    bool nested;            // declared inside another struct, related functions must be friends
+    QStringList annotations; // tags of the type from GeneratorConfig
+
+    QVector<MemberDescriptor> members; // Kind::Struct only
+    QStringList memberNames;
+    QStringList memberTypes;
+    QVector<int> declarationOrder; // member indices in the order they are declared in the struct, see MemberLayout
+    bool plain;                    // trivially copyable, padding-free and stored exactly as its encoding, see MemberLayout
+
+    QStringList enumItems;      // enumerator names, Kind::Enum/Kind::EnumClass only
+    QStringList enumItemsDecl;  // enumerators with their initializers
+    QString underlyingType;     // Kind::EnumClass only
+
+    TypeDescriptor()
+        : kind(Kind::Struct)
+        , nested(false)
+        , plain(false)
+    {}
+
+    inline QString friendPrefix() const { return nested ? "friend " : ""; }
+};
+
+/**
+ Pieces of code an emitter contributes to one declared type.
+ Emitters only append, the final layout is owned by CodeGen.
+ */
+struct TypeCode {
+    QString operators;  // inside the struct, always compiled
+    QString extra;      // inside the struct, under GBP_DECLARE_TYPE_GEN_ADDITIONALS
+    QString related;    // right after the type, in the enclosing scope
+    QString impl;       // source file
+    QString global;     // at global scope, after the enclosing namespaces (std specialisations)
+};
+
+/**
+ Output backend plugged into CodeGen.
+ All emitters are fed from the same traversal, so adding a backend does not add a tree walk.
+ */
+class Emitter
+{
+public:
+    virtual ~Emitter();
+
+    virtual QString name() const = 0;
+
+    /** called before each traversal */
+    virtual void begin();
+    virtual void emitStruct(const TypeDescriptor& type, TypeCode& code);
+    virtual void emitEnum(const TypeDescriptor& type, TypeCode& code);
+    /** standalone output of the backend, collected after the traversal */
+    virtual Code finish();
+
+protected:
+    /** wraps code into the GBP_DECLARE_TYPE_GEN_ADDITIONALS guard */
+    static QString additionalsOnly(const QString& code);
+    /** shifts every non-empty line by depth levels of four spaces */
+    static QString indented(const QString& code, int depth);
+};
@@ -0,0 +1,66 @@
+#include "enumemitter.hpp"
+#include "perfecthash.hpp"
+
+namespace
+{
+    QString quoted(const QStringList& names) {
+        QStringList result;
+        for (const QString& name: names) {
+            result << QString("\"%0\"").arg(name);
+        }
+        return result.join(", ");
+    }
+} //namespace
+
+QString EnumEmitter::name() const {
+    return "enum";
+}
+
+void EnumEmitter::emitEnum(const TypeDescriptor& type, TypeCode& code)
+{
+    QStringList values;
+    QStringList fullNames;
+    QStringList indexCases;
+    QStringList names;
+    QStringList assigns;
+
+    for (int i = 0; i < type.enumItems.size(); i++) {
+        const QString& item = type.enumItems.at(i);
+        QString value = QString("%0::%1").arg(type.fullName).arg(item);
+        values << value;
+        fullNames << value;
+        indexCases << QString("    case %0: return %1;\n").arg(value).arg(i);
+
+        QString assign = QString("e = %0;\n"
+                                 "        return true;").arg(value);
+        names << item << value;
+        assigns << assign << assign;
+    }
+
+    PerfectHash keys(names);
+
+    // %9 - friend if needed, the tables are constexpr so they are defined in place
+    code.related += QString("%9constexpr gbp::enum_table<%0, %1> gbp_enum_table(%0) {\n"
+                            "    return {{{%2}}, {{%3}}, {{%4}}};\n"
+                            "}\n"
+                            "%9constexpr std::size_t enum_index(%0 e) {\n"
+                            "    switch (e) {\n"
+                            "%5"
+                            "    }\n"
+                            "    return %1;\n"
+                            "}\n"
+                            "%9constexpr const char* enum_cast(%0 e, bool is_full_name = false) { return gbp::enum_name(e, is_full_name); }\n"
+                            "%9bool enum_from_string(std::string_view name, %0& e);\n")
+                        .arg(type.fullName)
+                        .arg(type.enumItems.size())
+                        .arg(values.join(", "))
+                        .arg(quoted(type.enumItems))
+                        .arg(quoted(fullNames))
+                        .arg(indexCases.join(""))
+                        .arg(type.friendPrefix());
+
+    code.impl += QString("bool enum_from_string(std::string_view name, %0& e) {\n"
+                         "%1"
+                         "    return false;\n"
+                         "}\n").arg(type.fullName).arg(indented(keys.dispatch("name", assigns), 1));
+}
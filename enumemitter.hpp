@@ -0,0 +1,17 @@
+#pragma once
+
+#include "emitter.hpp"
+
+/**
+ Enumerator tables (gbp_enum.hpp).
+ Every enum gets a constexpr gbp_enum_table() with values, short and full names in declaration order,
+ a dense enum_index(), enum_cast() reading the table and enum_from_string() dispatching through a perfect hash.
+ gbp::enum_count<E>, gbp::enum_values<E>() and gbp::enum_name() are built on top of them.
+ */
+class EnumEmitter : public Emitter
+{
+public:
+    virtual QString name() const override;
+
+    virtual void emitEnum(const TypeDescriptor& type, TypeCode& code) override;
+};
@@ -0,0 +1,79 @@
+#include "externemitter.hpp"
+
+#include <qregularexpression.h>
+
+QString ExternEmitter::name() const {
+    return "extern";
+}
+
+void ExternEmitter::begin()
+{
+    m_declared.clear();
+    m_elementTypes.clear();
+    m_instantiations.clear();
+}
+
+void ExternEmitter::emitStruct(const TypeDescriptor& type, TypeCode& /*code*/)
+{
+    static const QRegularExpression containerRe("^(std::(vector|deque))\\s*<(.+)>$");
+    static const QRegularExpression identifierRe("[A-Za-z_][A-Za-z_0-9:]*");
+
+    for (int i = 0; i < type.members.size(); i++) {
+        QRegularExpressionMatch match = containerRe.match(type.members.at(i).type);
+        if (!match.hasMatch()) {
+            continue;
+        }
+        // the standard only allows instantiations depending on a program-defined type,
+        // the same container spelled differently must be instantiated once
+        bool dependsOnDeclared = false;
+        QString element = match.captured(3).simplified();
+        QString canonical = match.captured(1) + "<";
+        int last = 0;
+        QRegularExpressionMatchIterator it = identifierRe.globalMatch(element);
+        while (it.hasNext()) {
+            QRegularExpressionMatch identifier = it.next();
+            canonical += element.mid(last, identifier.capturedStart() - last);
+            if (m_declared.contains(identifier.captured(0))) {
+                dependsOnDeclared = true;
+                canonical += m_declared.value(identifier.captured(0));
+            } else {
+                canonical += identifier.captured(0);
+            }
+            last = identifier.capturedEnd();
+        }
+        canonical += element.mid(last) + ">";
+        if (!dependsOnDeclared || m_elementTypes.contains(canonical)) {
+            continue;
+        }
+        m_elementTypes.insert(canonical);
+        // the element type spelled through the member, valid at global scope
+        QString instantiation = QString("%0<std::tuple_element<%1, ::%2::types_as_tuple>::type::value_type>")
+                                    .arg(match.captured(1)).arg(i).arg(type.qualifiedName);
+        m_instantiations << instantiation;
+    }
+
+    m_declared.insert(type.name, type.qualifiedName);
+    m_declared.insert(type.fullName, type.qualifiedName);
+    m_declared.insert(type.qualifiedName, type.qualifiedName);
+}
+
+void ExternEmitter::emitEnum(const TypeDescriptor& type, TypeCode& /*code*/)
+{
+    m_declared.insert(type.name, type.qualifiedName);
+    m_declared.insert(type.fullName, type.qualifiedName);
+    m_declared.insert(type.qualifiedName, type.qualifiedName);
+}
+
+Code ExternEmitter::finish()
+{
+    if (m_instantiations.isEmpty()) {
+        return Code();
+    }
+    QString decl = "// compiled once in the library\n";
+    QString impl;
+    for (const QString& instantiation: m_instantiations) {
+        decl += QString("extern template class %0;\n").arg(instantiation);
+        impl += QString("template class %0;\n").arg(instantiation);
+    }
+    return Code(decl, impl);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "emitter.hpp"
+
+#include <qhash.h>
+#include <QSet>
+
+/**
+ Explicit instantiations of std::vector and std::deque holding types declared in the same file.
+ Exported (CodeGen::exportedCode("extern")) rather than emitted per type:
+ decl has the extern template declarations appended to the generated header,
+ impl the instantiation definitions appended to its source, so they are compiled once for the library.
+ Other containers are left alone, instantiating all their members needs operator< (std::list::sort(),
+ merge(), the ordered containers) or std::hash of the key, which declared types do not have.
+ */
+class ExternEmitter : public Emitter
+{
+    QHash<QString, QString> m_declared; // qualified names of the types declared so far, by the names usable in member types
+    QSet<QString> m_elementTypes;       // canonical container types already instantiated
+    QStringList m_instantiations;       // in declaration order
+public:
+    virtual QString name() const override;
+
+    virtual void begin() override;
+    virtual void emitStruct(const TypeDescriptor& type, TypeCode& code) override;
+    virtual void emitEnum(const TypeDescriptor& type, TypeCode& code) override;
+    virtual Code finish() override;
+};
@@ -0,0 +1,78 @@
+#include "generatorconfig.hpp"
+
+#include <qdebug.h>
+#include <qfile.h>
+#include <qjsonarray.h>
+#include <qjsondocument.h>
+#include <qjsonobject.h>
+#include <qregularexpression.h>
+
+namespace
+{
+    /** "a, b" or ["a", "b"] of every key */
+    QHash<QString, QStringList> readTags(const QJsonObject& object)
+    {
+        QHash<QString, QStringList> result;
+        for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+            QStringList tags;
+            if (it.value().isArray()) {
+                for (const QJsonValue& tag: it.value().toArray()) {
+                    tags << tag.toString();
+                }
+            } else {
+                tags = it.value().toString().split(QRegularExpression("[\\s,]+"), QString::SkipEmptyParts);
+            }
+            result.insert(it.key(), tags);
+        }
+        return result;
+    }
+} //namespace
+
+QString GeneratorConfig::fileName() {
+    return "gbp-gen.json";
+}
+
+GeneratorConfig GeneratorConfig::forHeader(const QString& headerPath)
+{
+    static const QRegularExpression re("(.+/api)/");
+
+    GeneratorConfig config;
+    QString apiPath = re.match(headerPath).captured(1);
+    if (!apiPath.isEmpty() && QFile::exists(apiPath + "/" + fileName())) {
+        config.load(apiPath + "/" + fileName());
+    }
+    return config;
+}
+
+bool GeneratorConfig::load(const QString& path)
+{
+    m_memberAnnotations.clear();
+    m_typeAnnotations.clear();
+
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(f.readAll(), &error);
+    if (error.error != QJsonParseError::NoError) {
+        qWarning() << path << error.errorString();
+        return false;
+    }
+
+    m_memberAnnotations = readTags(doc.object().value("members").toObject());
+    m_typeAnnotations = readTags(doc.object().value("types").toObject());
+    return true;
+}
+
+bool GeneratorConfig::isEmpty() const {
+    return m_memberAnnotations.isEmpty() && m_typeAnnotations.isEmpty();
+}
+
+QStringList GeneratorConfig::memberAnnotations(const QString& qualifiedMemberName) const {
+    return m_memberAnnotations.value(qualifiedMemberName);
+}
+
+QStringList GeneratorConfig::typeAnnotations(const QString& qualifiedTypeName) const {
+    return m_typeAnnotations.value(qualifiedTypeName);
+}
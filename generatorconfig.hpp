@@ -0,0 +1,37 @@
+#pragma once
+
+#include <qhash.h>
+#include <qstring.h>
+#include <qstringlist.h>
+
+/**
+ Generator options kept next to the declarations instead of inside them,
+ read from gbp-gen.json in the api directory:
+ {
+     "members": {
+         "gbp::net::player_info::id": "varint",
+         "gbp::net::player_info::history": ["delta"]
+     },
+     "types": {
+         "gbp::net::player_info": "dirty"
+     }
+ }
+ Member keys are qualified with namespaces and enclosing structs, the tags are the same as in "gbp:" comments
+ inside member declarations, which take precedence.
+ Type keys are qualified the same way, their tags switch on optional generator modes.
+ */
+class GeneratorConfig
+{
+    QHash<QString, QStringList> m_memberAnnotations;
+    QHash<QString, QStringList> m_typeAnnotations;
+public:
+    static QString fileName();
+    /** the config of the api directory containing the header, empty if there is none */
+    static GeneratorConfig forHeader(const QString& headerPath);
+
+    bool load(const QString& path);
+    bool isEmpty() const;
+
+    QStringList memberAnnotations(const QString& qualifiedMemberName) const;
+    QStringList typeAnnotations(const QString& qualifiedTypeName) const;
+};
@@ -0,0 +1,29 @@
+#include "hashemitter.hpp"
+
+QString HashEmitter::name() const {
+    return "hash";
+}
+
+void HashEmitter::emitStruct(const TypeDescriptor& type, TypeCode& code)
+{
+    QStringList combines;
+    for (const QString& memberName: type.memberNames) {
+        combines << QString("        h = gbp::hash_combine(h, gbp::hash_value(obj.%0));\n").arg(memberName);
+    }
+    if (combines.isEmpty()) {
+        combines << "        (void)obj;\n";
+    }
+
+    code.global += additionalsOnly(QString("namespace std\n"
+                                           "{\n"
+                                           "template <>\n"
+                                           "struct hash<::%0>\n"
+                                           "{\n"
+                                           "    std::size_t operator()(const ::%0& obj) const {\n"
+                                           "        std::size_t h = gbp::hash_seed;\n"
+                                           "%1"
+                                           "        return h;\n"
+                                           "    }\n"
+                                           "};\n"
+                                           "} //namespace std").arg(type.qualifiedName).arg(combines.join("")));
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "emitter.hpp"
+
+/**
+ std::hash specialisations for structs (gbp_hash.hpp), member hashes are combined in declaration order.
+ Emitted at global scope, under GBP_DECLARE_TYPE_GEN_ADDITIONALS next to operator==.
+ */
+class HashEmitter : public Emitter
+{
+public:
+    virtual QString name() const override;
+
+    virtual void emitStruct(const TypeDescriptor& type, TypeCode& code) override;
+};
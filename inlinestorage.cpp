@@ -0,0 +1,38 @@
+#include "inlinestorage.hpp"
+
+#include <qregularexpression.h>
+
+QString InlineStorage::annotationPrefix() {
+    return "inline:";
+}
+
+int InlineStorage::capacity(const QStringList& annotations)
+{
+    for (const QString& annotation: annotations) {
+        if (annotation.startsWith(annotationPrefix())) {
+            bool ok = false;
+            int capacity = annotation.mid(annotationPrefix().size()).toInt(&ok);
+            return ok && capacity > 0 ? capacity : 0;
+        }
+    }
+    return 0;
+}
+
+QString InlineStorage::inlineType(const QString& type, int capacity)
+{
+    static const QRegularExpression vectorRe("^std::vector\\s*<(.+)>$");
+
+    QString name = type.simplified();
+    if (name == "std::string") {
+        return QString("gbp::fixed_string<%0>").arg(capacity);
+    }
+    QRegularExpressionMatch match = vectorRe.match(name);
+    if (match.hasMatch()) {
+        return QString("gbp::static_vector<%0, %1>").arg(match.captured(1).trimmed()).arg(capacity);
+    }
+    return type;
+}
+
+int InlineStorage::sizeTypeWidth(int capacity) {
+    return capacity < 256 ? 1 : capacity < 65536 ? 2 : 8;
+}
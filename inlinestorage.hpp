@@ -0,0 +1,21 @@
+#pragma once
+
+#include <qstring.h>
+#include <qstringlist.h>
+
+/**
+ Members annotated "inline:N" (gbp_fixed.hpp): std::string is declared as gbp::fixed_string<N>
+ and std::vector<T> as gbp::static_vector<T, N>, both keeping their elements inside the struct.
+ The codec, JSON and hashing treat them as the types they replace, so the formats do not change.
+ */
+class InlineStorage
+{
+public:
+    static QString annotationPrefix();
+    /** N of the first "inline:N" annotation, 0 without one */
+    static int capacity(const QStringList& annotations);
+    /** the inline replacement of type, type itself when it has none */
+    static QString inlineType(const QString& type, int capacity);
+    /** bytes of the size field of fixed_string<N> and static_vector<T, N> */
+    static int sizeTypeWidth(int capacity);
+};
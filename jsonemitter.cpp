@@ -0,0 +1,36 @@
+#include "jsonemitter.hpp"
+#include "perfecthash.hpp"
+
+QString JsonEmitter::name() const {
+    return "json";
+}
+
+void JsonEmitter::emitStruct(const TypeDescriptor& type, TypeCode& code)
+{
+    QStringList writes;
+    QStringList reads;
+
+    for (int i = 0; i < type.memberNames.size(); i++) {
+        const QString& memberName = type.memberNames.at(i);
+        // "{\"a\":" for the first key, ",\"b\":" for the next ones
+        writes << QString("    w.literal(\"%0\\\"%1\\\":\");\n"
+                          "    gbp::json::write(w, %1);\n").arg(i == 0 ? "{" : ",").arg(memberName);
+        reads << QString("return gbp::json::read(in, %0);").arg(memberName);
+    }
+    writes << (type.memberNames.isEmpty() ? "    w.literal(\"{}\");\n" : "    w.put('}');\n");
+
+    PerfectHash keys(type.memberNames);
+
+    code.operators += "void to_json(gbp::json::writer& w) const;\n";
+    code.operators += "bool from_json(gbp::json::reader& r);\n";
+    code.operators += "inline bool from_json(std::string_view text) { gbp::json::reader r(text); return from_json(r) && r.finish(); }\n";
+    code.impl += QString("void %0::to_json(gbp::json::writer& w) const {\n"
+                         "%1"
+                         "}\n").arg(type.fullName).arg(writes.join(""));
+    code.impl += QString("bool %0::from_json(gbp::json::reader& r) {\n"
+                         "    return r.read_object([this](gbp::json::reader& in, std::string_view key) {\n"
+                         "%1"
+                         "        return in.skip_value();\n"
+                         "    });\n"
+                         "}\n").arg(type.fullName).arg(indented(keys.dispatch("key", reads), 2));
+}
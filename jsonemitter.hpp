@@ -0,0 +1,17 @@
+#pragma once
+
+#include "emitter.hpp"
+
+/**
+ JSON input and output (gbp_json.hpp).
+ Structs get to_json(gbp::json::writer&) with the quoted keys and separators baked into literals,
+ operator<< is a thin wrapper over it.
+ from_json(gbp::json::reader&) dispatches member keys through a perfect hash, unknown keys are skipped.
+ */
+class JsonEmitter : public Emitter
+{
+public:
+    virtual QString name() const override;
+
+    virtual void emitStruct(const TypeDescriptor& type, TypeCode& code) override;
+};
@@ -0,0 +1,47 @@
+#include "layoutemitter.hpp"
+#include "dirtyemitter.hpp"
+#include "memberlayout.hpp"
+
+QString LayoutEmitter::name() const {
+    return "layout";
+}
+
+void LayoutEmitter::emitStruct(const TypeDescriptor& type, TypeCode& code)
+{
+    if (!type.annotations.contains(MemberLayout::annotation())) {
+        return;
+    }
+
+    QStringList emittedNames;
+    QStringList emittedIndices;
+    for (int i: type.declarationOrder) {
+        emittedNames << type.members.at(i).name;
+        emittedIndices << QString::number(i);
+    }
+    // member types as seen from the struct, the reports are also used outside of it
+    QString declaredTuple = QString("%0::types_as_tuple").arg(type.fullName);
+    QString emittedTuple = emittedIndices.isEmpty() ? QString("std::tuple<>")
+                                                    : QString("gbp::select_t<%0, %1>").arg(declaredTuple).arg(emittedIndices.join(", "));
+    QString declared = QString("gbp::layout_of_tuple<%0>()").arg(declaredTuple);
+    QString emitted = QString("gbp::layout_of_tuple<%0>()").arg(emittedTuple);
+
+    // the dirty mask is the only data member declared besides the members
+    QString data = emitted;
+    if (type.annotations.contains(DirtyEmitter::annotation())) {
+        data = QString("gbp::layout_of_tuple<%0, gbp::patch_mask<%1::member_count>>()").arg(emittedTuple).arg(type.fullName);
+    }
+
+    code.extra += QString("/** size, alignment and padding of the members in declaration order and as emitted */\n"
+                          "constexpr static gbp::layout_info declared_layout = %0;\n"
+                          "constexpr static gbp::layout_info emitted_layout = %1;\n").arg(declared).arg(emitted);
+
+    code.related += QString("// layout of %0: declared as %1; emitted as %2\n"
+                            "static_assert(sizeof(%0) == %3.size, \"%0: unexpected layout\");\n"
+                            "static_assert(%4.size <= %5.size, \"%0: the emitted member order takes more space than the declared one\");\n")
+                        .arg(type.fullName)
+                        .arg(type.memberNames.join(", "))
+                        .arg(emittedNames.join(", "))
+                        .arg(data)
+                        .arg(emitted)
+                        .arg(declared);
+}
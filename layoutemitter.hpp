@@ -0,0 +1,18 @@
+#pragma once
+
+#include "emitter.hpp"
+
+/**
+ Layout report for types tagged "layout" in GeneratorConfig (gbp_layout.hpp).
+ CodeGen emits the member declarations in MemberLayout::packedOrder(), the logical member order
+ (get_member<N>, member_name<N>, serialize, wire format) is unchanged.
+ The types get declared_layout/emitted_layout with the size and padding of both orders,
+ and static_asserts on their sizeof.
+ */
+class LayoutEmitter : public Emitter
+{
+public:
+    virtual QString name() const override;
+
+    virtual void emitStruct(const TypeDescriptor& type, TypeCode& code) override;
+};
@@ -0,0 +1,174 @@
+#include "memberlayout.hpp"
+#include "inlinestorage.hpp"
+
+#include <qregularexpression.h>
+
+#include <algorithm>
+
+namespace
+{
+    const QHash<QString, MemberLayout::Layout>& builtinLayouts()
+    {
+        static const QHash<QString, MemberLayout::Layout> layouts = {
+            {"bool",               MemberLayout::Layout(1, 1)},
+            {"char",               MemberLayout::Layout(1, 1, true)},
+            {"gbp_i8",             MemberLayout::Layout(1, 1, true)},
+            {"gbp_u8",             MemberLayout::Layout(1, 1, true)},
+            {"gbp_i16",            MemberLayout::Layout(2, 2, true)},
+            {"gbp_u16",            MemberLayout::Layout(2, 2, true)},
+            {"gbp_i32",            MemberLayout::Layout(4, 4, true)},
+            {"gbp_u32",            MemberLayout::Layout(4, 4, true)},
+            {"int",                MemberLayout::Layout(4, 4, true)},
+            // bool decodes any non-zero byte as true, floating point compares unequal to itself
+            {"float",              MemberLayout::Layout(4, 4)},
+            {"gbp_i64",            MemberLayout::Layout(8, 8, true)},
+            {"gbp_u64",            MemberLayout::Layout(8, 8, true)},
+            {"double",             MemberLayout::Layout(8, 8)},
+            // 4 bytes on 32 bit targets, never plain so that the encoding does not depend on the target
+            {"std::size_t",        MemberLayout::Layout(8, 8)},
+            {"std::string",        MemberLayout::Layout(32, 8)},
+            {"std::vector",        MemberLayout::Layout(24, 8)},
+            {"std::list",          MemberLayout::Layout(24, 8)},
+            {"std::deque",         MemberLayout::Layout(80, 8)},
+            {"std::set",           MemberLayout::Layout(48, 8)},
+            {"std::multiset",      MemberLayout::Layout(48, 8)},
+            {"std::map",           MemberLayout::Layout(48, 8)},
+            {"std::multimap",      MemberLayout::Layout(48, 8)},
+            {"std::unordered_set", MemberLayout::Layout(56, 8)},
+            {"std::unordered_map", MemberLayout::Layout(56, 8)},
+            // the polymorphic allocator adds a memory_resource pointer
+            {"std::pmr::string",        MemberLayout::Layout(40, 8)},
+            {"std::pmr::vector",        MemberLayout::Layout(32, 8)},
+            {"std::pmr::list",          MemberLayout::Layout(32, 8)},
+            {"std::pmr::deque",         MemberLayout::Layout(88, 8)},
+            {"std::pmr::set",           MemberLayout::Layout(56, 8)},
+            {"std::pmr::multiset",      MemberLayout::Layout(56, 8)},
+            {"std::pmr::map",           MemberLayout::Layout(56, 8)},
+            {"std::pmr::multimap",      MemberLayout::Layout(56, 8)},
+            {"std::pmr::unordered_set", MemberLayout::Layout(64, 8)},
+            {"std::pmr::unordered_map", MemberLayout::Layout(64, 8)},
+        };
+        return layouts;
+    }
+
+    inline int alignedTo(int offset, int align) {
+        return (offset + align - 1) / align * align;
+    }
+} //namespace
+
+QString MemberLayout::annotation() {
+    return "layout";
+}
+
+void MemberLayout::clear() {
+    m_known.clear();
+}
+
+void MemberLayout::addType(const QString& qualifiedName, const Layout& layout) {
+    m_known.insert(qualifiedName, layout);
+}
+
+bool MemberLayout::resolve(const QString& name, const QString& scope, Layout& layout) const
+{
+    if (name.startsWith("::")) {
+        layout = m_known.value(name.mid(2), layout);
+        return m_known.contains(name.mid(2));
+    }
+    // innermost scope first, like the compiler
+    QStringList scopes = scope.split("::", QString::SkipEmptyParts);
+    for (int i = scopes.size(); i >= 0; i--) {
+        QString candidate = i > 0 ? QStringList(scopes.mid(0, i)).join("::") + "::" + name : name;
+        if (m_known.contains(candidate)) {
+            layout = m_known.value(candidate);
+            return true;
+        }
+    }
+    return false;
+}
+
+MemberLayout::Layout MemberLayout::typeLayout(const QString& type, const QString& scope) const
+{
+    QString name = type.simplified();
+    if (name.endsWith('*')) {
+        return Layout(8, 8);
+    }
+    Layout known;
+    if (resolve(name, scope, known)) {
+        return known;
+    }
+    // inline storage: the elements followed by the size field
+    static const QRegularExpression fixedStringRe("^gbp::fixed_string<\\s*(\\d+)\\s*>$");
+    static const QRegularExpression staticVectorRe("^gbp::static_vector<(.+),\\s*(\\d+)\\s*>$");
+    QRegularExpressionMatch match = fixedStringRe.match(name);
+    if (match.hasMatch()) {
+        int capacity = match.captured(1).toInt();
+        int width = InlineStorage::sizeTypeWidth(capacity);
+        return Layout(alignedTo(capacity + 1 + width, width), width);
+    }
+    match = staticVectorRe.match(name);
+    if (match.hasMatch()) {
+        Layout element = typeLayout(match.captured(1), scope);
+        int capacity = match.captured(2).toInt();
+        int width = InlineStorage::sizeTypeWidth(capacity);
+        int align = qMax(element.align, width);
+        return Layout(alignedTo(alignedTo(qMax(1, capacity * element.size), width) + width, align), align);
+    }
+    // templates by their name, the arguments do not change the size of the standard containers
+    QString templateName = name.section('<', 0, 0).trimmed();
+    if (builtinLayouts().contains(templateName)) {
+        return builtinLayouts().value(templateName);
+    }
+    // declared elsewhere or brought in by a using declaration, the size is a guess and it is never plain
+    QString lastName = templateName.section("::", -1);
+    QVector<Layout> candidates;
+    for (const QString& known: m_known.keys()) {
+        if (known == lastName || known.endsWith("::" + lastName)) {
+            candidates << m_known.value(known);
+        }
+    }
+    if (candidates.size() == 1) {
+        return Layout(candidates.first().size, candidates.first().align);
+    }
+    // unknown types are usually classes holding pointers
+    return Layout(8, 8);
+}
+
+MemberLayout::Layout MemberLayout::structLayout(const QStringList& types, const QString& scope) const
+{
+    Layout result(0, 1);
+    for (const QString& type: types) {
+        Layout member = typeLayout(type, scope);
+        result.size = alignedTo(result.size, member.align) + member.size;
+        result.align = qMax(result.align, member.align);
+    }
+    result.size = qMax(1, alignedTo(result.size, result.align));
+    return result;
+}
+
+QVector<int> MemberLayout::packedOrder(const QStringList& types, const QString& scope) const
+{
+    QVector<int> order;
+    QVector<Layout> layouts;
+    for (int i = 0; i < types.size(); i++) {
+        order << i;
+        layouts << typeLayout(types.at(i), scope);
+    }
+    // with power of two alignments and sizes that are multiples of them, no padding is left between the members
+    std::stable_sort(order.begin(), order.end(), [&layouts](int a, int b) {
+        return layouts.at(a).align > layouts.at(b).align;
+    });
+    return order;
+}
+
+bool MemberLayout::isPlain(const QStringList& types, const QString& scope) const
+{
+    int size = 0;
+    for (const QString& type: types) {
+        Layout member = typeLayout(type, scope);
+        if (!member.plain) {
+            return false;
+        }
+        size += member.size;
+    }
+    return size > 0 && structLayout(types, scope).size == size;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <qhash.h>
+#include <qstring.h>
+#include <qstringlist.h>
+#include <QVector>
+
+/**
+ Estimated size and alignment of member types (LP64, libstdc++), used to pick a padding-minimising
+ declaration order for types tagged "layout" in GeneratorConfig.
+ The estimate only orders the members, the generated static_asserts check the real layout.
+ Enums and structs declared earlier in the same file are known by their qualified names, member types are looked up
+ from the scope of their struct outwards. A name found only by its last component may be another type and is not plain.
+ Plain types are stored exactly as their fixed width encoding: integers, enums and padding-free
+ structs of plain members.
+ */
+class MemberLayout
+{
+public:
+    struct Layout {
+        int size;
+        int align;
+        bool plain;
+
+        Layout(int size = 0, int align = 1, bool plain = false)
+            : size(size)
+            , align(align)
+            , plain(plain)
+        {}
+    };
+private:
+    QHash<QString, Layout> m_known; // by qualified name
+
+    bool resolve(const QString& name, const QString& scope, Layout& layout) const;
+public:
+    static QString annotation();
+
+    void clear();
+    void addType(const QString& qualifiedName, const Layout& layout);
+
+    /** scope is the qualified name of the struct or namespace the type is named in */
+    Layout typeLayout(const QString& type, const QString& scope) const;
+    /** members laid out in the given order */
+    Layout structLayout(const QStringList& types, const QString& scope) const;
+    /** member indices by descending alignment, the declaration order is kept for equal ones */
+    QVector<int> packedOrder(const QStringList& types, const QString& scope) const;
+    /** every member is plain and the given order leaves no padding */
+    bool isPlain(const QStringList& types, const QString& scope) const;
+};
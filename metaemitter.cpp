@@ -0,0 +1,45 @@
+#include "metaemitter.hpp"
+
+/**
+ %0 - qualified struct name
+ %1 - member table
+ %2 - member count
+ %3 - the member table, nullptr without members
+ */
+constexpr static const char* codeTmpDescriptor =
+R"code(GBP_META_BEGIN
+namespace gbp
+{
+namespace meta
+{
+template <>
+struct descriptor<::%0>
+{
+    using type = ::%0;
+%1
+    constexpr static type_info value = {"%0", sizeof(type), alignof(type), %3, %2};
+};
+} //namespace meta
+} //namespace gbp
+GBP_META_END)code";
+
+QString MetaEmitter::name() const {
+    return "meta";
+}
+
+void MetaEmitter::emitStruct(const TypeDescriptor& type, TypeCode& code)
+{
+    QStringList entries;
+    for (int i = 0; i < type.members.size(); i++) {
+        entries << QString("        describe_member<type, %0>(\"%1\", offsetof(type, %1))").arg(i).arg(type.members.at(i).name);
+    }
+
+    QString table = entries.isEmpty() ? QString() : QString("    constexpr static member_info members[] = {\n"
+                                                            "%0\n"
+                                                            "    };\n").arg(entries.join(",\n"));
+
+    code.global += additionalsOnly(QString(codeTmpDescriptor).arg(type.qualifiedName)
+                                                             .arg(table)
+                                                             .arg(type.members.size())
+                                                             .arg(entries.isEmpty() ? "nullptr" : "members"));
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "emitter.hpp"
+
+/**
+ Reflection tables (gbp_meta.hpp): every struct gets a gbp::meta::descriptor specialisation
+ with the offset, size, type code and wire of each member and the descriptors of nested types.
+ The non-templated functions of gbp_meta.cpp work on any declared type through it.
+ */
+class MetaEmitter : public Emitter
+{
+public:
+    virtual QString name() const override;
+
+    virtual void emitStruct(const TypeDescriptor& type, TypeCode& code) override;
+};
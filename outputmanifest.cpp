@@ -0,0 +1,141 @@
+#include "outputmanifest.hpp"
+
+#include <qcryptographichash.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <QSaveFile>
+
+OutputManifest::OutputManifest(const QString& rootPath)
+    : m_rootPath(rootPath)
+    , m_previous()
+    , m_pending()
+    , m_current()
+    , m_mutex()
+{}
+
+QString OutputManifest::fileName() {
+    return "api-gen.manifest";
+}
+
+QByteArray OutputManifest::hash(const QByteArray& content) {
+    return QCryptographicHash::hash(content, QCryptographicHash::Sha1).toHex();
+}
+
+bool OutputManifest::load()
+{
+    m_previous.clear();
+
+    QFile f(absolutePath(fileName()));
+    if (!f.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    // one "<hash>[*] <relative path>" per line, * marks formatted sources
+    while (!f.atEnd()) {
+        QByteArray line = f.readLine().trimmed();
+        int sep = line.indexOf(' ');
+        if (sep > 0) {
+            QByteArray hash = line.left(sep);
+            bool formatted = hash.endsWith('*');
+            if (formatted) {
+                hash.chop(1);
+            }
+            m_previous.insert(QString::fromUtf8(line.mid(sep + 1)), Entry(hash, formatted));
+        }
+    }
+    return true;
+}
+
+bool OutputManifest::save() const
+{
+    QMutexLocker locker(&m_mutex);
+    QSaveFile f(absolutePath(fileName()));
+    if (!f.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    for (auto it = m_current.cbegin(); it != m_current.cend(); ++it) {
+        f.write(it.value().hash + (it.value().formatted ? "* " : " ") + it.key().toUtf8() + '\n');
+    }
+    return f.commit();
+}
+
+bool OutputManifest::update(const QString& path, const QByteArray& content, bool format)
+{
+    QString relPath = relativePath(path);
+    QByteArray contentHash = hash(content);
+
+    QMutexLocker locker(&m_mutex);
+    Entry previous = m_previous.value(relPath);
+    if (previous.hash == contentHash && (previous.formatted || !format) && QFileInfo::exists(absolutePath(relPath))) {
+        m_current.insert(relPath, previous);
+        return false;
+    }
+    m_pending.insert(relPath, Entry(contentHash));
+    return true;
+}
+
+void OutputManifest::commit(const QString& path, bool formatted)
+{
+    QString relPath = relativePath(path);
+
+    QMutexLocker locker(&m_mutex);
+    if (m_pending.contains(relPath)) {
+        Entry entry = m_pending.take(relPath);
+        entry.formatted = formatted;
+        m_current.insert(relPath, entry);
+    }
+}
+
+bool OutputManifest::isChanged(const QString& path) const
+{
+    QString relPath = relativePath(path);
+
+    QMutexLocker locker(&m_mutex);
+    QByteArray current = m_pending.contains(relPath) ? m_pending.value(relPath).hash : m_current.value(relPath).hash;
+    return !m_previous.contains(relPath) || m_previous.value(relPath).hash != current;
+}
+
+bool OutputManifest::contains(const QString& path) const
+{
+    QString relPath = relativePath(path);
+
+    QMutexLocker locker(&m_mutex);
+    return m_pending.contains(relPath) || m_current.contains(relPath);
+}
+
+QStringList OutputManifest::stale() const
+{
+    QMutexLocker locker(&m_mutex);
+    QStringList lst;
+    for (auto it = m_previous.cbegin(); it != m_previous.cend(); ++it) {
+        if (!m_pending.contains(it.key()) && !m_current.contains(it.key())) {
+            lst << it.key();
+        }
+    }
+    return lst;
+}
+
+int OutputManifest::removeStale(const std::function<bool(const QString&)>& orphaned)
+{
+    int count = 0;
+    for (const QString& relPath: stale()) {
+        if (!orphaned(absolutePath(relPath))) {
+            QMutexLocker locker(&m_mutex);
+            m_current.insert(relPath, m_previous.value(relPath));
+            continue;
+        }
+        if (QFile::remove(absolutePath(relPath))) {
+            count++;
+        }
+        QFile::remove(absolutePath(relPath) + ".tmp");
+    }
+    return count;
+}
+
+QString OutputManifest::relativePath(const QString& path) const {
+    return QDir(m_rootPath).relativeFilePath(path);
+}
+
+QString OutputManifest::absolutePath(const QString& relativePath) const {
+    return QDir(m_rootPath).absoluteFilePath(relativePath);
+}
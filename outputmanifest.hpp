@@ -0,0 +1,63 @@
+#pragma once
+
+#include <qbytearray.h>
+#include <qmap.h>
+#include <qmutex.h>
+#include <qstring.h>
+#include <qstringlist.h>
+
+#include <functional>
+
+/**
+ Content hashes of everything written into the output directory.
+ Lets the generator leave unchanged files (and their mtimes) alone and drop outputs of removed sources.
+ Hashes are taken from the generated text, before any formatting; sources written unformatted are marked
+ so they get formatted once a formatter is available.
+ A new hash only counts once the file is on disk (commit()), a failed write leaves the output out of the
+ saved manifest so the next run writes it again.
+ */
+class OutputManifest
+{
+public:
+    struct Entry {
+        QByteArray hash;
+        bool formatted;
+
+        Entry(const QByteArray& hash = QByteArray(), bool formatted = false)
+            : hash(hash)
+            , formatted(formatted)
+        {}
+    };
+private:
+    QString m_rootPath;
+    QMap<QString, Entry> m_previous;
+    QMap<QString, Entry> m_pending; // registered, waiting for the write
+    QMap<QString, Entry> m_current;
+    mutable QMutex m_mutex;
+public:
+    explicit OutputManifest(const QString& rootPath);
+
+    static QString fileName();
+    static QByteArray hash(const QByteArray& content);
+
+    bool load();
+    bool save() const;
+
+    /** registers the output and returns true if it has to be written, or formatted when format is set */
+    bool update(const QString& path, const QByteArray& content, bool format = false);
+    /** the output returned by update() is written, thread safe */
+    void commit(const QString& path, bool formatted = false);
+    bool isChanged(const QString& path) const;
+    bool contains(const QString& path) const;
+
+    /** outputs of the previous run which were not registered in this one */
+    QStringList stale() const;
+    /**
+     deletes the stale outputs orphaned(absolute path) agrees on,
+     the others keep their entries: their sources exist but were not generated this time
+     */
+    int removeStale(const std::function<bool(const QString&)>& orphaned);
+
+    QString relativePath(const QString& path) const;
+    QString absolutePath(const QString& relativePath) const;
+};
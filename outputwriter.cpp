@@ -0,0 +1,174 @@
+#include "outputwriter.hpp"
+
+#include <qdir.h>
+#include <qelapsedtimer.h>
+#include <qfileinfo.h>
+#include <qlist.h>
+#include <qmutex.h>
+#include <qqueue.h>
+#include <qset.h>
+#include <qthread.h>
+#include <qwaitcondition.h>
+#include <QSaveFile>
+
+struct OutputWriter::Impl
+{
+    struct Job {
+        QString path;
+        QByteArray content;
+        Completion done;
+    };
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_notEmpty;
+    QWaitCondition m_notFull;
+    QWaitCondition m_drained;
+    QQueue<Job> m_queue;
+    qint64 m_pendingBytes;
+    const qint64 m_maxPendingBytes;
+    int m_active;
+    bool m_stopping;
+    QSet<QString> m_dirs;
+    QList<QThread*> m_threads;
+    QElapsedTimer m_timer;
+    Stats m_stats;
+
+    Impl(qint64 maxPendingBytes)
+        : m_mutex()
+        , m_queue()
+        , m_pendingBytes(0)
+        , m_maxPendingBytes(maxPendingBytes)
+        , m_active(0)
+        , m_stopping(false)
+        , m_dirs()
+        , m_threads()
+        , m_timer()
+        , m_stats()
+    {
+        m_timer.start();
+    }
+
+    void ensureDir(const QString& dir)
+    {
+        // created under the lock, so no thread can open a file before its directory exists
+        QMutexLocker locker(&m_mutex);
+        if (!m_dirs.contains(dir)) {
+            QDir().mkpath(dir);
+            m_dirs.insert(dir);
+        }
+    }
+
+    bool writeFile(const Job& job)
+    {
+        ensureDir(QFileInfo(job.path).absolutePath());
+
+        QSaveFile file(job.path);
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(job.content);
+            return file.commit();
+        }
+        return false;
+    }
+
+    void run()
+    {
+        forever {
+            Job job;
+            {
+                QMutexLocker locker(&m_mutex);
+                while (m_queue.isEmpty() && !m_stopping) {
+                    m_notEmpty.wait(&m_mutex);
+                }
+                if (m_queue.isEmpty()) {
+                    return;
+                }
+                job = m_queue.dequeue();
+                m_active++;
+            }
+
+            bool ok = writeFile(job);
+            if (job.done) {
+                job.done(ok);
+            }
+
+            QMutexLocker locker(&m_mutex);
+            m_pendingBytes -= job.content.size();
+            m_active--;
+            if (ok) {
+                m_stats.files++;
+                m_stats.bytes += job.content.size();
+            } else {
+                m_stats.failed++;
+            }
+            m_notFull.wakeAll();
+            if (m_queue.isEmpty() && m_active == 0) {
+                m_drained.wakeAll();
+            }
+        }
+    }
+};
+
+OutputWriter::OutputWriter(int threadCount, qint64 maxPendingBytes)
+    : m_impl(new Impl(maxPendingBytes))
+{
+    if (threadCount <= 0) {
+        threadCount = qMax(1, QThread::idealThreadCount());
+    }
+    for (int i = 0; i < threadCount; i++) {
+        QThread* thread = QThread::create([this]{ m_impl->run(); });
+        m_impl->m_threads << thread;
+        thread->start();
+    }
+}
+
+OutputWriter::~OutputWriter()
+{
+    finish();
+    delete m_impl;
+}
+
+void OutputWriter::write(const QString& path, const QByteArray& content, const Completion& done)
+{
+    QMutexLocker locker(&m_impl->m_mutex);
+    Q_ASSERT(!m_impl->m_stopping);
+
+    // a single buffer larger than the limit is still accepted once the queue is empty
+    while (m_impl->m_pendingBytes > 0 && m_impl->m_pendingBytes + content.size() > m_impl->m_maxPendingBytes) {
+        m_impl->m_notFull.wait(&m_impl->m_mutex);
+    }
+    m_impl->m_queue.enqueue(Impl::Job{path, content, done});
+    m_impl->m_pendingBytes += content.size();
+    m_impl->m_notEmpty.wakeOne();
+}
+
+void OutputWriter::wait()
+{
+    QMutexLocker locker(&m_impl->m_mutex);
+    while (!m_impl->m_queue.isEmpty() || m_impl->m_active > 0) {
+        m_impl->m_drained.wait(&m_impl->m_mutex);
+    }
+}
+
+OutputWriter::Stats OutputWriter::finish()
+{
+    {
+        QMutexLocker locker(&m_impl->m_mutex);
+        m_impl->m_stopping = true;
+        m_impl->m_notEmpty.wakeAll();
+    }
+    for (QThread* thread: m_impl->m_threads) {
+        thread->wait();
+        delete thread;
+    }
+    m_impl->m_threads.clear();
+
+    return stats();
+}
+
+OutputWriter::Stats OutputWriter::stats() const
+{
+    QMutexLocker locker(&m_impl->m_mutex);
+    Stats stats = m_impl->m_stats;
+    stats.elapsedMs = m_impl->m_timer.elapsed();
+    return stats;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <qbytearray.h>
+#include <qstring.h>
+
+#include <functional>
+
+/**
+ Writes generated files on a pool of threads.
+ Buffers are handed over through a bounded queue: write() blocks while too many bytes are pending,
+ so a fast producer cannot pile up the whole output in memory.
+ Every file is written to a temporary file and renamed on success (QSaveFile).
+ */
+class OutputWriter
+{
+public:
+    struct Stats {
+        int files;
+        int failed;
+        qint64 bytes;
+        qint64 elapsedMs;
+
+        Stats()
+            : files(0)
+            , failed(0)
+            , bytes(0)
+            , elapsedMs(0)
+        {}
+    };
+    /** called on a writer thread once the file is written or failed to be */
+    using Completion = std::function<void(bool ok)>;
+private:
+    struct Impl;
+    Impl* m_impl;
+public:
+    explicit OutputWriter(int threadCount = 0, qint64 maxPendingBytes = 16 * 1024 * 1024);
+    ~OutputWriter();
+
+    OutputWriter(const OutputWriter&) = delete;
+    OutputWriter& operator=(const OutputWriter&) = delete;
+
+    void write(const QString& path, const QByteArray& content, const Completion& done = Completion());
+    /** blocks until everything queued so far is on disk */
+    void wait();
+    /** waits for the queue to drain and stops the threads */
+    Stats finish();
+    Stats stats() const;
+};
@@ -3,6 +3,7 @@
 #include "codegen.hpp"
 #include "contextmodel.hpp"
 #include "gbpparser.hpp"
+#include "generatorconfig.hpp"
 
 #include <QLineEdit>
 #include <QFileDialog>
@@ -99,6 +100,8 @@ void Page::init(const QString &filepath)
         connect(m_impl->m_codegen, &CodeGen::implCodeChanged, m_impl->codegenBrowser_impl, &QTextBrowser::setPlainText);
         connect(m_impl->m_codegenFragment, &CodeGen::declCodeChanged, m_impl->codegenBrowser_fragment_decl, &QTextBrowser::setPlainText);
         connect(m_impl->m_codegenFragment, &CodeGen::implCodeChanged, m_impl->codegenBrowser_fragment_impl, &QTextBrowser::setPlainText);
+        m_impl->m_codegenFragment->setSource(m_impl->m_codegen);
+        m_impl->m_codegen->setConfig(GeneratorConfig::forHeader(filepath));
         m_impl->m_codegen->setModel(m_impl->m_model);
         m_impl->m_codegenFragment->setModel(m_impl->m_model);
     }
@@ -148,6 +151,10 @@ QString Page::implCode() const {
     return m_impl->codegenBrowser_impl->toPlainText();
 }
 
+Code Page::exportedCode(const QString& emitterName) const {
+    return m_impl->m_codegen->exportedCode(emitterName);
+}
+
 void Page::changeEvent(QEvent *e)
 {
     QWidget::changeEvent(e);
@@ -3,6 +3,7 @@
 #include <qabstractitemmodel.h>
 #include <qtreeview.h>
 #include <qtextbrowser.h>
+#include "codegen.hpp"
 #include "context.hpp"
 //class Context;
 
@@ -61,6 +62,8 @@ public:
     QString filepath() const;
     QString declCode() const;
     QString implCode() const;
+    /** standalone output of an emitter, see CodeGen::exportedCode */
+    Code exportedCode(const QString& emitterName) const;
 protected:
     void changeEvent(QEvent *e);
 private slots:
@@ -8,7 +8,31 @@ HEADERS += $$PWD/gbpparser.hpp \
     codegen.hpp \
     contextmodel.hpp \
     page.h \
-    checkedfileslist.hpp
+    checkedfileslist.hpp \
+    emitter.hpp \
+    outputmanifest.hpp \
+    outputwriter.hpp \
+    sourceformatter.hpp \
+    runtime.hpp \
+    codecemitter.hpp \
+    viewemitter.hpp \
+    generatorconfig.hpp \
+    jsonemitter.hpp \
+    perfecthash.hpp \
+    enumemitter.hpp \
+    hashemitter.hpp \
+    patchemitter.hpp \
+    dirtyemitter.hpp \
+    layoutemitter.hpp \
+    memberlayout.hpp \
+    externemitter.hpp \
+    columnsemitter.hpp \
+    allocatoremitter.hpp \
+    poolemitter.hpp \
+    inlinestorage.hpp \
+    metaemitter.hpp \
+    registryemitter.hpp \
+    schemaemitter.hpp
 
 SOURCES += $$PWD/gbpparser.cpp \
            $$PWD/main.cpp \
@@ -17,7 +41,31 @@ SOURCES += $$PWD/gbpparser.cpp \
     codegen.cpp \
     contextmodel.cpp \
     page.cpp \
-    checkedfileslist.cpp
+    checkedfileslist.cpp \
+    emitter.cpp \
+    outputmanifest.cpp \
+    outputwriter.cpp \
+    sourceformatter.cpp \
+    runtime.cpp \
+    codecemitter.cpp \
+    viewemitter.cpp \
+    generatorconfig.cpp \
+    jsonemitter.cpp \
+    perfecthash.cpp \
+    enumemitter.cpp \
+    hashemitter.cpp \
+    patchemitter.cpp \
+    dirtyemitter.cpp \
+    layoutemitter.cpp \
+    memberlayout.cpp \
+    externemitter.cpp \
+    columnsemitter.cpp \
+    allocatoremitter.cpp \
+    poolemitter.cpp \
+    inlinestorage.cpp \
+    metaemitter.cpp \
+    registryemitter.cpp \
+    schemaemitter.cpp
 
 FORMS += \
     page.ui \
@@ -0,0 +1,49 @@
+#include "patchemitter.hpp"
+#include "codecemitter.hpp"
+
+QString PatchEmitter::name() const {
+    return "patch";
+}
+
+void PatchEmitter::emitStruct(const TypeDescriptor& type, TypeCode& code)
+{
+    QStringList compares;
+    QStringList writes;
+    QStringList reads;
+
+    for (int i = 0; i < type.members.size(); i++) {
+        const MemberDescriptor& member = type.members.at(i);
+        QString wire = CodecEmitter::wireType(member);
+        if (wire.isEmpty()) {
+            wire = "gbp::wire::fixed";
+        }
+        compares << QString("    mask.set(%0, !(from.%1 == to.%1));\n").arg(i).arg(member.name);
+        writes << QString("    if (mask.test(%0)) {\n"
+                          "        gbp::codec::write_patch<%2>(patch, from.%1, to.%1);\n"
+                          "    }\n").arg(i).arg(member.name).arg(wire);
+        reads << QString("(!mask.test(%0) || gbp::codec::read_patch<%2>(in, %1))").arg(i).arg(member.name).arg(wire);
+    }
+    reads.prepend("mask.read(in)");
+
+    code.extra += QString("/** the members of to that differ from from, nested declared types as nested patches */\n"
+                          "static void diff(const %0& from, const %0& to, gbp::buffer& patch);\n"
+                          "static inline gbp::buffer diff(const %0& from, const %0& to) { gbp::buffer patch; diff(from, to, patch); return patch; }\n"
+                          "bool apply_patch(gbp::reader& in);\n"
+                          "/** fails unless the whole patch is consumed */\n"
+                          "inline bool apply_patch(gbp::byte_span patch) { gbp::reader r(patch); return apply_patch(r) && r.at_end(); }\n").arg(type.name);
+
+    code.impl += additionalsOnly(QString("void %0::diff(const %0& from, const %0& to, gbp::buffer& patch) {\n"
+                                         "    gbp::patch_mask<%1> mask;\n"
+                                         "%2"
+                                         "    mask.write(patch);\n"
+                                         "%3"
+                                         "}\n"
+                                         "bool %0::apply_patch(gbp::reader& in) {\n"
+                                         "    gbp::patch_mask<%1> mask;\n"
+                                         "    return %4;\n"
+                                         "}\n").arg(type.fullName)
+                                               .arg(type.members.size())
+                                               .arg(compares.join(""))
+                                               .arg(writes.join(""))
+                                               .arg(reads.join("\n        && ")));
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "emitter.hpp"
+
+/**
+ Field level diff and patch (gbp_patch.hpp).
+ Structs get a static diff(from, to) writing a bitmask of the changed members followed by their new values,
+ and apply_patch() reading it back. Members of declared types are diffed recursively,
+ the others are written with the same wire encoding as in encode().
+ */
+class PatchEmitter : public Emitter
+{
+public:
+    virtual QString name() const override;
+
+    virtual void emitStruct(const TypeDescriptor& type, TypeCode& code) override;
+};
@@ -0,0 +1,74 @@
+#include "perfecthash.hpp"
+
+#include <QSet>
+
+PerfectHash::PerfectHash(const QStringList& keys)
+    : m_keys(keys)
+    , m_seed(0)
+    , m_mask(0)
+    , m_slots()
+{
+    QList<QByteArray> raw;
+    for (const QString& key: keys) {
+        raw << key.toUtf8();
+    }
+
+    quint32 size = 1;
+    while (size < quint32(raw.size())) {
+        size <<= 1;
+    }
+
+    // a few hundred seeds are enough for a table of the next power of two, otherwise the table grows
+    forever {
+        for (quint32 seed = 0; seed < 256; seed++) {
+            QVector<quint32> candidate;
+            QSet<quint32> used;
+            for (const QByteArray& key: raw) {
+                quint32 slot = hash(key, seed) & (size - 1);
+                if (used.contains(slot)) {
+                    break;
+                }
+                used.insert(slot);
+                candidate << slot;
+            }
+            if (candidate.size() == raw.size()) {
+                m_seed = seed;
+                m_mask = size - 1;
+                m_slots = candidate;
+                return;
+            }
+        }
+        size <<= 1;
+    }
+}
+
+quint32 PerfectHash::hash(const QByteArray& key, quint32 seed)
+{
+    quint32 h = 2166136261u ^ seed;
+    for (char c: key) {
+        h ^= quint32(uchar(c));
+        h *= 16777619u;
+    }
+    h ^= h >> 13;
+    h *= 0x5bd1e995u;
+    h ^= h >> 15;
+    return h;
+}
+
+QString PerfectHash::dispatch(const QString& keyExpr, const QStringList& bodies) const
+{
+    if (m_keys.isEmpty()) {
+        return QString("(void)%0;\n").arg(keyExpr);
+    }
+
+    QString code = QString("switch (gbp::key_hash(%0, %1u) & %2u) {\n").arg(keyExpr).arg(m_seed).arg(m_mask);
+    for (int i = 0; i < m_keys.size(); i++) {
+        code += QString("case %0:\n"
+                        "    if (%1 == \"%2\") {\n"
+                        "        %3\n"
+                        "    }\n"
+                        "    break;\n").arg(m_slots.at(i)).arg(keyExpr).arg(m_keys.at(i)).arg(bodies.at(i));
+    }
+    code += "}\n";
+    return code;
+}
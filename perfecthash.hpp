@@ -0,0 +1,32 @@
+#pragma once
+
+#include <qstring.h>
+#include <qstringlist.h>
+#include <QVector>
+
+/**
+ Collision-free slot table over a fixed set of names, used to dispatch on strings with one hash and one compare.
+ The hash is gbp::key_hash from gbp_hash.hpp, a seed is searched until every key lands in its own slot.
+ */
+class PerfectHash
+{
+    QStringList m_keys;
+    quint32 m_seed;
+    quint32 m_mask;
+    QVector<quint32> m_slots;
+public:
+    explicit PerfectHash(const QStringList& keys);
+
+    /** same result as gbp::key_hash */
+    static quint32 hash(const QByteArray& key, quint32 seed);
+
+    inline quint32 seed() const { return m_seed; }
+    inline quint32 mask() const { return m_mask; }
+    inline quint32 slotOf(int i) const { return m_slots.at(i); }
+
+    /**
+     switch over the slot of keyExpr (a std::string_view), bodies[i] runs when the key equals keys[i],
+     unknown keys fall through past the switch
+     */
+    QString dispatch(const QString& keyExpr, const QStringList& bodies) const;
+};
@@ -0,0 +1,35 @@
+#include "poolemitter.hpp"
+#include "dirtyemitter.hpp"
+
+QString PoolEmitter::annotation() {
+    return "pool";
+}
+
+QString PoolEmitter::name() const {
+    return "pool";
+}
+
+void PoolEmitter::emitStruct(const TypeDescriptor& type, TypeCode& code)
+{
+    QStringList resets;
+
+    for (const MemberDescriptor& member: type.members) {
+        // the default value is assigned in place, so the member keeps its buffer
+        resets << (member.value.isEmpty() ? QString("gbp::reset_value(%0);").arg(member.name)
+                                          : QString("%0 = {%1};").arg(member.name).arg(member.value));
+    }
+    if (type.annotations.contains(DirtyEmitter::annotation())) {
+        resets << "clear_dirty();";
+    }
+
+    code.extra += QString("/** the default constructed state, strings and containers keep their capacity */\n"
+                          "inline void reset() {\n"
+                          "%0\n"
+                          "}\n").arg(indented(resets.join("\n"), 1));
+
+    if (type.annotations.contains(annotation())) {
+        code.extra += QString("/** a reset object from the pool of the calling thread, returned to it when destroyed */\n"
+                              "static inline gbp::pooled<%0> acquire() { return gbp::pool<%0>::local().acquire(); }\n"
+                              "static inline void release(%0* obj) { gbp::pool<%0>::local().release(obj); }\n").arg(type.name);
+    }
+}
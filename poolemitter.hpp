@@ -0,0 +1,19 @@
+#pragma once
+
+#include "emitter.hpp"
+
+/**
+ Object reuse (gbp_pool.hpp).
+ Every struct gets reset(), returning the members to their default values while strings and containers
+ keep their capacity. Types tagged "pool" in GeneratorConfig also get acquire()/release()
+ over a thread local gbp::pool of reset objects.
+ */
+class PoolEmitter : public Emitter
+{
+public:
+    static QString annotation();
+
+    virtual QString name() const override;
+
+    virtual void emitStruct(const TypeDescriptor& type, TypeCode& code) override;
+};
@@ -0,0 +1,196 @@
+#include "registryemitter.hpp"
+#include "perfecthash.hpp"
+
+#include <qdebug.h>
+#include <QSet>
+
+namespace
+{
+    /** same result as gbp::hash_mix */
+    quint64 hashMix(quint64 h) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    /** a seed putting every id into its own slot of a table of size entries, false if none of the first 256 does */
+    bool findPositions(const QVector<quint32>& ids, quint32 size, quint32& seed, QVector<quint32>& positions)
+    {
+        for (seed = 0; seed < 256; seed++) {
+            QSet<quint32> used;
+            positions.clear();
+            for (quint32 id: ids) {
+                quint32 slot = quint32(hashMix(id ^ seed) & (size - 1));
+                if (used.contains(slot)) {
+                    break;
+                }
+                used.insert(slot);
+                positions << slot;
+            }
+            if (positions.size() == ids.size()) {
+                return true;
+            }
+        }
+        return false;
+    }
+} //namespace
+
+/**
+ %0 - includes of the generated headers
+ %1 - type count
+ %2 - slot seed
+ %3 - slot mask
+ %4 - visit cases
+ */
+constexpr static const char* codeTmpRegistryDecl =
+R"code(#pragma once
+#include "gbp_registry.hpp"
+%0
+#ifdef GBP_DECLARE_TYPE_GEN_ADDITIONALS
+namespace gbp
+{
+namespace registry
+{
+constexpr static const std::size_t type_count = %1;
+
+/** position of an id in the registry, different for every registered id */
+constexpr std::size_t slot(gbp_u32 id) { return static_cast<std::size_t>(gbp::hash_mix(id ^ %2u) & %3u); }
+
+/** nullptr for unknown ids */
+const registered_type* find(gbp_u32 id);
+
+/** decodes data as the type with the id and passes the value to handler, false for unknown ids and invalid data */
+template <typename Handler>
+inline bool visit(gbp_u32 id, byte_span data, Handler&& handler)
+{
+    switch (slot(id)) {
+%4    }
+    return false;
+}
+} //namespace registry
+} //namespace gbp
+#endif //GBP_DECLARE_TYPE_GEN_ADDITIONALS
+)code";
+
+/**
+ %0 - slot table entries
+ */
+constexpr static const char* codeTmpRegistryImpl =
+R"code(#include "api_registry.hpp"
+
+#ifdef GBP_DECLARE_TYPE_GEN_ADDITIONALS
+namespace gbp
+{
+namespace registry
+{
+namespace
+{
+constexpr registered_type types[] = {
+%0
+};
+} //namespace
+
+const registered_type* find(gbp_u32 id)
+{
+    const registered_type& type = types[slot(id)];
+    return type.info && type.id == id ? &type : nullptr;
+}
+} //namespace registry
+} //namespace gbp
+#endif //GBP_DECLARE_TYPE_GEN_ADDITIONALS
+)code";
+
+QString RegistryEmitter::name() const {
+    return "registry";
+}
+
+void RegistryEmitter::begin()
+{
+    m_types.clear();
+}
+
+void RegistryEmitter::emitStruct(const TypeDescriptor& type, TypeCode& code)
+{
+    code.operators += QString("constexpr static const gbp_u32 type_id = gbp::key_hash(\"%0\", 0);\n").arg(type.qualifiedName);
+    m_types << type.qualifiedName;
+}
+
+Code RegistryEmitter::finish()
+{
+    return Code(m_types.join('\n'), QString());
+}
+
+quint32 RegistryEmitter::typeId(const QString& qualifiedName)
+{
+    return PerfectHash::hash(qualifiedName.toUtf8(), 0);
+}
+
+Code RegistryEmitter::projectRegistry(const QStringList& includes, const QStringList& types)
+{
+    QStringList registered;
+    QVector<quint32> ids;
+    QHash<quint32, QString> byId;
+    QStringList collisions;
+    for (const QString& type: types) {
+        quint32 id = typeId(type);
+        if (byId.contains(id)) {
+            if (byId.value(id) != type) {
+                qWarning() << "type id of" << type << "collides with" << byId.value(id);
+                collisions << QString("#error \"type id of %0 collides with %1, rename one of them\"").arg(type).arg(byId.value(id));
+            }
+            continue;
+        }
+        byId.insert(id, type);
+        registered << type;
+        ids << id;
+    }
+    // messages of one type would be decoded as the other, the registry must not build
+    if (!collisions.isEmpty()) {
+        return Code("#pragma once\n" + collisions.join('\n') + "\n", collisions.join('\n') + "\n");
+    }
+    if (registered.isEmpty()) {
+        return Code();
+    }
+
+    // the same search as PerfectHash, over the ids
+    quint32 size = 1;
+    while (size < quint32(ids.size())) {
+        size <<= 1;
+    }
+    quint32 seed = 0;
+    QVector<quint32> positions;
+    while (!findPositions(ids, size, seed, positions)) {
+        size <<= 1;
+    }
+
+    QStringList includeLines;
+    for (const QString& include: includes) {
+        includeLines << QString("#include \"%0\"").arg(include);
+    }
+
+    QStringList table;
+    QStringList cases;
+    for (quint32 slot = 0; slot < size; slot++) {
+        table << "    registered_type{},";
+        cases << QString();
+    }
+    for (int i = 0; i < registered.size(); i++) {
+        int slot = int(positions.at(i));
+        table[slot] = QString("    make_registered<::%0>(),").arg(registered.at(i));
+        cases[slot] = QString("    case %0:\n"
+                              "        if (id == ::%1::type_id) {\n"
+                              "            return visit_as<::%1>(data, std::forward<Handler>(handler));\n"
+                              "        }\n"
+                              "        break;\n").arg(slot).arg(registered.at(i));
+    }
+
+    return Code(QString(codeTmpRegistryDecl).arg(includeLines.join('\n'))
+                                            .arg(registered.size())
+                                            .arg(seed)
+                                            .arg(size - 1)
+                                            .arg(cases.join(QString())),
+                QString(codeTmpRegistryImpl).arg(table.join('\n')));
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "emitter.hpp"
+
+/**
+ Type ids and the project registry (gbp_registry.hpp).
+ Every struct gets type_id, gbp::key_hash of its qualified name, so routing code can switch on a number.
+ Exported (CodeGen::exportedCode("registry")) rather than emitted per type: decl lists the qualified names
+ of the structs, one per line. TabWidget collects them from every header and writes the project registry
+ with projectRegistry(): a slot table of the types for gbp::registry::find() and a gbp::registry::visit()
+ switching over the same slots. Types whose ids collide make the registry an #error.
+ */
+class RegistryEmitter : public Emitter
+{
+    QStringList m_types; // qualified names in declaration order
+public:
+    virtual QString name() const override;
+
+    virtual void begin() override;
+    virtual void emitStruct(const TypeDescriptor& type, TypeCode& code) override;
+    virtual Code finish() override;
+
+    /** same result as T::type_id */
+    static quint32 typeId(const QString& qualifiedName);
+    /** header and source of the registry over the types exported by the headers, empty without types */
+    static Code projectRegistry(const QStringList& includes, const QStringList& types);
+};
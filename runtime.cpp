@@ -0,0 +1,3524 @@
+#include "runtime.hpp"
+
+constexpr static const char* runtimeDeclareType =
+R"(
+#ifndef _gbp__api__declare_type
+#define _gbp__api__declare_type
+#include "gbp_int.hpp"
+#include "gbp_alloc.hpp"
+#include "gbp_fixed.hpp"
+#include "gbp_hash.hpp"
+#include "gbp_enum.hpp"
+#include "gbp_layout.hpp"
+#include "gbp_columns.hpp"
+#include "gbp_pool.hpp"
+#include "gbp_codec.hpp"
+#include "gbp_patch.hpp"
+#include "gbp_view.hpp"
+#include <api/declare_type/decorators.hpp>
+#include <api/declare_type/list.hpp>
+#include <api/declare_type/map.hpp>
+#include <api/declare_type/pair.hpp>
+#include <api/declare_type/quoting.hpp>
+#include <api/declare_type/set.hpp>
+#include <api/declare_type/tuple.hpp>
+#include <api/declare_type/unordered_map.hpp>
+#include <api/declare_type/unordered_multimap.hpp>
+#include <api/declare_type/unordered_set.hpp>
+#include <api/declare_type/vector.hpp>
+#include "gbp_json.hpp"
+#include "gbp_meta.hpp"
+#include <array>
+#include <sstream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#define GBP_DECLARE_TYPE(...)
+#define GBP_DECLARE_ENUM(...)
+#define GBP_DECLARE_ENUM_SIMPLE(...)
+template<typename T>
+struct is_gbp_type
+{
+private:
+    typedef char yes;
+    typedef short no;
+
+    template<typename C> static yes test(typename C::types_as_tuple*);
+    template<typename C> static no  test(...);
+public:
+    static const bool value = sizeof(test<T>(0)) == sizeof(yes);
+    typedef T type;
+};
+namespace _detail {
+    template <typename T, typename F, std::size_t... N>
+    inline void apply_helper(T* obj, F& f, std::index_sequence<N...>) {
+        (f(T::member_names[N], obj->template get_member<N>()), ...);
+    }
+
+    template <typename T, typename U, typename F, std::size_t... N>
+    inline bool cmp_helper(T* obj1, U* obj2, F& f, std::index_sequence<N...>) {
+        bool result = false;
+        ((obj1->template get_member<N>() != obj2->template get_member<N>()
+          ? (f(T::member_names[N], obj1->template get_member<N>(), obj2->template get_member<N>()), result = true)
+          : false), ...);
+        return result;
+    }
+} //namespace _detail
+
+namespace gbp {
+    // T may be const, members are passed with the same constness
+    template <typename T, typename F>
+    inline void invoke_apply(T* obj, F&& f) {
+        _detail::apply_helper(obj, f, std::make_index_sequence<std::remove_const<T>::type::member_count>());
+    }
+
+    template <typename T, typename F>
+    inline bool invoke_cmp(T* obj1, const T* obj2, F&& f) {
+        return _detail::cmp_helper(obj1, obj2, f, std::make_index_sequence<T::member_count>());
+    }
+    template <typename T, typename F>
+    inline bool invoke_cmp(const T* obj1, const T* obj2, F&& f) {
+        return _detail::cmp_helper(obj1, obj2, f, std::make_index_sequence<T::member_count>());
+    }
+
+    // folded over the elements rather than asking std::tuple: the tuple trait may be instantiated
+    // while a nested type is still incomplete and would stay false for the whole translation unit
+    template <typename Tuple> struct nothrow_move;
+    template <typename... T>
+    struct nothrow_move<std::tuple<T...>>
+    {
+        static constexpr bool construct = (std::is_nothrow_move_constructible<T>::value && ...);
+        static constexpr bool assign = (std::is_nothrow_move_assignable<T>::value && ...);
+    };
+} //namespace gbp
+#endif)";
+
+constexpr static const char* runtimeInt =
+R"(#pragma once
+
+using gbp_i64 = long long int;
+using gbp_u64 = unsigned long long int;
+using gbp_i32 = int;
+using gbp_u32 = unsigned int;
+using gbp_i16 = short;
+using gbp_u16 = unsigned short;
+using gbp_i8  = signed char;
+using gbp_u8  = unsigned char;)";
+
+constexpr static const char* runtimeCodec =
+R"(#pragma once
+#include "gbp_int.hpp"
+#include "gbp_alloc.hpp"
+#include "gbp_fixed.hpp"
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Compact binary format of GBP types:
+// integers and floating point values are little-endian and fixed width, bool is one byte,
+// enums are written as their underlying type, strings and containers are prefixed with a varint element count,
+// GBP types are their members in declaration order.
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define GBP_CODEC_BIG_ENDIAN
+#endif
+
+namespace gbp {
+namespace wire {
+    // per-member encodings requested with /*gbp: ...*/ annotations
+    struct fixed {};    // the natural encoding of the type
+    struct varint {};   // LEB128, integers and containers of integers that are mostly small and non-negative
+    struct zigzag {};   // zigzag + LEB128, integers and containers of integers that are mostly small
+    struct delta {};    // containers of integers: difference to the previous element, zigzag + LEB128
+} //namespace wire
+
+    class buffer
+    {
+        std::vector<unsigned char> m_data;
+    public:
+        inline void reserve(std::size_t size) { m_data.reserve(size); }
+        inline void clear() { m_data.clear(); }
+        inline std::size_t size() const { return m_data.size(); }
+        inline const unsigned char* data() const { return m_data.data(); }
+        inline const std::vector<unsigned char>& bytes() const { return m_data; }
+
+        inline void put(unsigned char byte) { m_data.push_back(byte); }
+        inline void put(const void* src, std::size_t size) {
+            if (size != 0) {
+                std::size_t pos = m_data.size();
+                m_data.resize(pos + size);
+                std::memcpy(m_data.data() + pos, src, size);
+            }
+        }
+    };
+
+    struct byte_span
+    {
+        const unsigned char* data;
+        std::size_t size;
+
+        constexpr byte_span() : data(nullptr), size(0) {}
+        constexpr byte_span(const unsigned char* data, std::size_t size) : data(data), size(size) {}
+        byte_span(const buffer& buf) : data(buf.data()), size(buf.size()) {}
+        byte_span(const std::vector<unsigned char>& bytes) : data(bytes.data()), size(bytes.size()) {}
+        byte_span(const std::string& bytes) : data(reinterpret_cast<const unsigned char*>(bytes.data())), size(bytes.size()) {}
+    };
+
+    // bounds checked cursor over encoded bytes, every read fails instead of running past the end
+    class reader
+    {
+        const unsigned char* m_pos;
+        const unsigned char* m_end;
+    public:
+        explicit reader(byte_span in) : m_pos(in.data), m_end(in.data + in.size) {}
+
+        inline std::size_t remaining() const { return static_cast<std::size_t>(m_end - m_pos); }
+        inline bool at_end() const { return m_pos == m_end; }
+        inline const unsigned char* position() const { return m_pos; }
+
+        inline bool get(unsigned char& byte) {
+            if (m_pos == m_end) {
+                return false;
+            }
+            byte = *m_pos++;
+            return true;
+        }
+        inline bool read(void* dst, std::size_t size) {
+            if (remaining() < size) {
+                return false;
+            }
+            if (size != 0) {
+                std::memcpy(dst, m_pos, size);
+            }
+            m_pos += size;
+            return true;
+        }
+        inline bool skip(std::size_t size) {
+            if (remaining() < size) {
+                return false;
+            }
+            m_pos += size;
+            return true;
+        }
+    };
+
+namespace codec {
+    template <typename T, typename Enable = void>
+    struct traits; // not defined for types that cannot be encoded
+
+    template <typename T> inline void write(buffer& buf, const T& value) { traits<T>::write(buf, value); }
+    template <typename T> inline bool read(reader& in, T& value) { return traits<T>::read(in, value); }
+    // moves past one encoded value without decoding it
+    template <typename T> inline bool skip(reader& in) { return traits<T>::skip(in); }
+
+    template <typename Wire, typename T, typename Enable = void>
+    struct wire_traits; // not defined when the encoding does not apply to T
+
+    template <typename Wire, typename T> inline void write_as(buffer& buf, const T& value) { wire_traits<Wire, T>::write(buf, value); }
+    template <typename Wire, typename T> inline bool read_as(reader& in, T& value) { return wire_traits<Wire, T>::read(in, value); }
+    template <typename Wire, typename T> inline bool skip_as(reader& in) { return wire_traits<Wire, T>::skip(in); }
+
+    template <typename T> struct wire_traits<wire::fixed, T> : traits<T> {};
+
+    // encoding of the member N of a GBP type, types without annotated members have no wire_types
+    template <typename T, std::size_t N, typename = void>
+    struct member_wire { using type = wire::fixed; };
+    template <typename T, std::size_t N>
+    struct member_wire<T, N, std::void_t<typename T::wire_types>> { using type = typename std::tuple_element<N, typename T::wire_types>::type; };
+    template <typename T, std::size_t N>
+    using member_wire_t = typename member_wire<T, N>::type;
+
+    inline void write_varint(buffer& buf, gbp_u64 value) {
+        while (value >= 0x80) {
+            buf.put(static_cast<unsigned char>(value | 0x80));
+            value >>= 7;
+        }
+        buf.put(static_cast<unsigned char>(value));
+    }
+    inline bool read_varint(reader& in, gbp_u64& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            unsigned char byte;
+            if (!in.get(byte)) {
+                return false;
+            }
+            value |= static_cast<gbp_u64>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename T>
+    inline void write_fixed(buffer& buf, T value) {
+#ifdef GBP_CODEC_BIG_ENDIAN
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        for (std::size_t i = 0; i < sizeof(T); i++) {
+            buf.put(bytes[sizeof(T) - 1 - i]);
+        }
+#else
+        buf.put(&value, sizeof(T));
+#endif
+    }
+    template <typename T>
+    inline bool read_fixed(reader& in, T& value) {
+#ifdef GBP_CODEC_BIG_ENDIAN
+        unsigned char bytes[sizeof(T)];
+        for (std::size_t i = 0; i < sizeof(T); i++) {
+            if (!in.get(bytes[sizeof(T) - 1 - i])) {
+                return false;
+            }
+        }
+        std::memcpy(&value, bytes, sizeof(T));
+        return true;
+#else
+        return in.read(&value, sizeof(T));
+#endif
+    }
+
+    inline void write_count(buffer& buf, std::size_t count) {
+        write_varint(buf, count);
+    }
+    inline bool read_count(reader& in, std::size_t& count) {
+        gbp_u64 value;
+        if (!read_varint(in, value) || value > static_cast<gbp_u64>(static_cast<std::size_t>(-1))) {
+            return false;
+        }
+        count = static_cast<std::size_t>(value);
+        return true;
+    }
+
+namespace detail {
+    template <typename T, typename = void> struct has_member_codec : std::false_type {};
+    template <typename T> struct has_member_codec<T, std::void_t<decltype(std::declval<const T&>().encode(std::declval<buffer&>()))>> : std::true_type {};
+
+    // enum codecs generated next to the enum, found by ADL
+    template <typename T, typename = void> struct has_adl_codec : std::false_type {};
+    template <typename T> struct has_adl_codec<T, std::void_t<decltype(encode(std::declval<buffer&>(), std::declval<T>()))>> : std::true_type {};
+
+    template <typename C, typename = void> struct has_reserve : std::false_type {};
+    template <typename C> struct has_reserve<C, std::void_t<decltype(std::declval<C&>().reserve(std::size_t()))>> : std::true_type {};
+
+    // the count comes from the wire, never reserve more than the input could hold
+    template <typename C>
+    inline void reserve(C& c, std::size_t count, const reader& in) {
+        if constexpr (has_reserve<C>::value) {
+            c.reserve(count < in.remaining() ? count : in.remaining());
+        }
+    }
+
+    // generated types of integers and enums without padding, their memory image is their encoding
+    template <typename T, typename = void> struct is_plain : std::false_type {};
+    template <typename T> struct is_plain<T, typename std::enable_if<T::plain_layout>::type> : std::true_type {};
+
+    template <typename T>
+    constexpr bool is_trivially_copied = (std::is_arithmetic<T>::value && !std::is_same<T, bool>::value) || is_plain<T>::value;
+
+    template <typename C>
+    inline void write_range(buffer& buf, const C& c) {
+        write_count(buf, c.size());
+        for (const auto& item: c) {
+            write(buf, item);
+        }
+    }
+
+    // existing elements are decoded in place so their own buffers are reused
+    template <typename C>
+    inline bool read_sequence(reader& in, C& c) {
+        std::size_t count;
+        if (!read_count(in, count) || count > c.max_size()) {
+            return false;
+        }
+        reserve(c, count, in);
+        auto it = c.begin();
+        for (std::size_t i = 0; i < count; i++) {
+            if (it == c.end()) {
+                c.emplace_back();
+                it = std::prev(c.end());
+            }
+            if (!read(in, *it)) {
+                return false;
+            }
+            ++it;
+        }
+        c.erase(it, c.end());
+        return true;
+    }
+
+    template <typename T>
+    inline bool skip_range(reader& in) {
+        std::size_t count;
+        if (!read_count(in, count)) {
+            return false;
+        }
+        if constexpr (is_trivially_copied<T>) {
+            return count <= in.remaining() / sizeof(T) && in.skip(count * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < count; i++) {
+                if (!skip<T>(in)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    template <typename C>
+    inline bool read_set(reader& in, C& c) {
+        std::size_t count;
+        if (!read_count(in, count)) {
+            return false;
+        }
+        c.clear();
+        reserve(c, count, in);
+        for (std::size_t i = 0; i < count; i++) {
+            auto item = make_element<typename C::value_type>(c);
+            if (!read(in, item)) {
+                return false;
+            }
+            c.insert(c.end(), std::move(item));
+        }
+        return true;
+    }
+
+    template <typename C>
+    inline void write_map(buffer& buf, const C& c) {
+        write_count(buf, c.size());
+        for (const auto& item: c) {
+            write(buf, item.first);
+            write(buf, item.second);
+        }
+    }
+    template <typename C>
+    inline bool read_map(reader& in, C& c) {
+        std::size_t count;
+        if (!read_count(in, count)) {
+            return false;
+        }
+        c.clear();
+        reserve(c, count, in);
+        for (std::size_t i = 0; i < count; i++) {
+            auto key = make_element<typename C::key_type>(c);
+            auto value = make_element<typename C::mapped_type>(c);
+            if (!read(in, key) || !read(in, value)) {
+                return false;
+            }
+            c.emplace_hint(c.end(), std::move(key), std::move(value));
+        }
+        return true;
+    }
+
+    template <typename T, std::size_t... N>
+    inline void write_tuple(buffer& buf, const T& value, std::index_sequence<N...>) {
+        (write(buf, std::get<N>(value)), ...);
+    }
+    template <typename T, std::size_t... N>
+    inline bool read_tuple(reader& in, T& value, std::index_sequence<N...>) {
+        return (read(in, std::get<N>(value)) && ...);
+    }
+    template <typename T, std::size_t... N>
+    inline bool skip_tuple(reader& in, std::index_sequence<N...>) {
+        return (skip<typename std::tuple_element<N, T>::type>(in) && ...);
+    }
+    template <typename T, std::size_t... N>
+    inline bool skip_members(reader& in, std::index_sequence<N...>) {
+        return (skip_as<member_wire_t<T, N>, typename std::tuple_element<N, typename T::types_as_tuple>::type>(in) && ...);
+    }
+} //namespace detail
+
+    template <>
+    struct traits<bool>
+    {
+        static inline void write(buffer& buf, bool value) { buf.put(value ? 1 : 0); }
+        static inline bool read(reader& in, bool& value) {
+            unsigned char byte;
+            if (!in.get(byte)) {
+                return false;
+            }
+            value = byte != 0;
+            return true;
+        }
+        static inline bool skip(reader& in) { return in.skip(1); }
+    };
+
+    template <typename T>
+    struct traits<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+    {
+        static inline void write(buffer& buf, T value) { write_fixed(buf, value); }
+        static inline bool read(reader& in, T& value) { return read_fixed(in, value); }
+        static inline bool skip(reader& in) { return in.skip(sizeof(T)); }
+    };
+
+    template <typename T>
+    struct traits<T, typename std::enable_if<std::is_enum<T>::value>::type>
+    {
+        using underlying = typename std::underlying_type<T>::type;
+
+        static inline void write(buffer& buf, T value) {
+            if constexpr (detail::has_adl_codec<T>::value) {
+                encode(buf, value);
+            } else {
+                write_fixed(buf, static_cast<underlying>(value));
+            }
+        }
+        static inline bool read(reader& in, T& value) {
+            if constexpr (detail::has_adl_codec<T>::value) {
+                return decode(in, value);
+            } else {
+                underlying raw;
+                if (!read_fixed(in, raw)) {
+                    return false;
+                }
+                value = static_cast<T>(raw);
+                return true;
+            }
+        }
+        static inline bool skip(reader& in) {
+            T value;
+            return read(in, value);
+        }
+    };
+
+    // GBP types, encode/decode are generated
+    template <typename T>
+    struct traits<T, typename std::enable_if<detail::has_member_codec<T>::value>::type>
+    {
+        static inline void write(buffer& buf, const T& value) { value.encode(buf); }
+        static inline bool read(reader& in, T& value) { return value.decode(in); }
+        static inline bool skip(reader& in) {
+            return detail::skip_members<T>(in, std::make_index_sequence<T::member_count>());
+        }
+    };
+
+    template <typename C, typename Tr, typename A>
+    struct traits<std::basic_string<C, Tr, A>>
+    {
+        static inline void write(buffer& buf, const std::basic_string<C, Tr, A>& value) {
+            write_count(buf, value.size());
+            if constexpr (sizeof(C) == 1) {
+                buf.put(value.data(), value.size());
+            } else {
+                for (C c: value) {
+                    write_fixed(buf, c);
+                }
+            }
+        }
+        static inline bool read(reader& in, std::basic_string<C, Tr, A>& value) {
+            std::size_t count;
+            if (!read_count(in, count) || count > in.remaining() / sizeof(C)) {
+                return false;
+            }
+            if constexpr (sizeof(C) == 1) {
+                value.assign(reinterpret_cast<const C*>(in.position()), count);
+                return in.skip(count);
+            } else {
+                value.resize(count);
+                for (C& c: value) {
+                    read_fixed(in, c);
+                }
+                return true;
+            }
+        }
+        static inline bool skip(reader& in) {
+            std::size_t count;
+            return read_count(in, count) && count <= in.remaining() / sizeof(C) && in.skip(count * sizeof(C));
+        }
+    };
+
+    template <typename T, typename A>
+    struct traits<std::vector<T, A>>
+    {
+        static inline void write(buffer& buf, const std::vector<T, A>& value) {
+#ifndef GBP_CODEC_BIG_ENDIAN
+            if constexpr (detail::is_trivially_copied<T>) {
+                write_count(buf, value.size());
+                buf.put(value.data(), value.size() * sizeof(T));
+                return;
+            }
+#endif
+            detail::write_range(buf, value);
+        }
+        static inline bool read(reader& in, std::vector<T, A>& value) {
+#ifndef GBP_CODEC_BIG_ENDIAN
+            if constexpr (detail::is_trivially_copied<T>) {
+                std::size_t count;
+                if (!read_count(in, count) || count > in.remaining() / sizeof(T)) {
+                    return false;
+                }
+                value.resize(count);
+                return in.read(value.data(), count * sizeof(T));
+            }
+#endif
+            return detail::read_sequence(in, value);
+        }
+        static inline bool skip(reader& in) { return detail::skip_range<T>(in); }
+    };
+
+    // bit proxies cannot be read in place, one byte per element like bool
+    template <typename A>
+    struct traits<std::vector<bool, A>>
+    {
+        static inline void write(buffer& buf, const std::vector<bool, A>& value) { detail::write_range(buf, value); }
+        static inline bool read(reader& in, std::vector<bool, A>& value) {
+            std::size_t count;
+            if (!read_count(in, count) || count > in.remaining()) {
+                return false;
+            }
+            value.resize(count);
+            for (std::size_t i = 0; i < count; i++) {
+                bool item;
+                if (!codec::read(in, item)) {
+                    return false;
+                }
+                value[i] = item;
+            }
+            return true;
+        }
+        static inline bool skip(reader& in) { return detail::skip_range<bool>(in); }
+    };
+
+    template <typename T, typename A>
+    struct traits<std::deque<T, A>>
+    {
+        static inline void write(buffer& buf, const std::deque<T, A>& value) { detail::write_range(buf, value); }
+        static inline bool read(reader& in, std::deque<T, A>& value) { return detail::read_sequence(in, value); }
+        static inline bool skip(reader& in) { return detail::skip_range<T>(in); }
+    };
+
+    template <typename T, typename A>
+    struct traits<std::list<T, A>>
+    {
+        static inline void write(buffer& buf, const std::list<T, A>& value) { detail::write_range(buf, value); }
+        static inline bool read(reader& in, std::list<T, A>& value) { return detail::read_sequence(in, value); }
+        static inline bool skip(reader& in) { return detail::skip_range<T>(in); }
+    };
+
+    template <typename T, typename Cmp, typename A>
+    struct traits<std::set<T, Cmp, A>>
+    {
+        static inline void write(buffer& buf, const std::set<T, Cmp, A>& value) { detail::write_range(buf, value); }
+        static inline bool read(reader& in, std::set<T, Cmp, A>& value) { return detail::read_set(in, value); }
+        static inline bool skip(reader& in) { return detail::skip_range<T>(in); }
+    };
+
+    template <typename T, typename Cmp, typename A>
+    struct traits<std::multiset<T, Cmp, A>>
+    {
+        static inline void write(buffer& buf, const std::multiset<T, Cmp, A>& value) { detail::write_range(buf, value); }
+        static inline bool read(reader& in, std::multiset<T, Cmp, A>& value) { return detail::read_set(in, value); }
+        static inline bool skip(reader& in) { return detail::skip_range<T>(in); }
+    };
+
+    template <typename T, typename H, typename Eq, typename A>
+    struct traits<std::unordered_set<T, H, Eq, A>>
+    {
+        static inline void write(buffer& buf, const std::unordered_set<T, H, Eq, A>& value) { detail::write_range(buf, value); }
+        static inline bool read(reader& in, std::unordered_set<T, H, Eq, A>& value) { return detail::read_set(in, value); }
+        static inline bool skip(reader& in) { return detail::skip_range<T>(in); }
+    };
+
+    template <typename T, typename H, typename Eq, typename A>
+    struct traits<std::unordered_multiset<T, H, Eq, A>>
+    {
+        static inline void write(buffer& buf, const std::unordered_multiset<T, H, Eq, A>& value) { detail::write_range(buf, value); }
+        static inline bool read(reader& in, std::unordered_multiset<T, H, Eq, A>& value) { return detail::read_set(in, value); }
+        static inline bool skip(reader& in) { return detail::skip_range<T>(in); }
+    };
+
+    template <typename K, typename V, typename Cmp, typename A>
+    struct traits<std::map<K, V, Cmp, A>>
+    {
+        static inline void write(buffer& buf, const std::map<K, V, Cmp, A>& value) { detail::write_map(buf, value); }
+        static inline bool read(reader& in, std::map<K, V, Cmp, A>& value) { return detail::read_map(in, value); }
+        static inline bool skip(reader& in) { return detail::skip_range<std::pair<K, V>>(in); }
+    };
+
+    template <typename K, typename V, typename Cmp, typename A>
+    struct traits<std::multimap<K, V, Cmp, A>>
+    {
+        static inline void write(buffer& buf, const std::multimap<K, V, Cmp, A>& value) { detail::write_map(buf, value); }
+        static inline bool read(reader& in, std::multimap<K, V, Cmp, A>& value) { return detail::read_map(in, value); }
+        static inline bool skip(reader& in) { return detail::skip_range<std::pair<K, V>>(in); }
+    };
+
+    template <typename K, typename V, typename H, typename Eq, typename A>
+    struct traits<std::unordered_map<K, V, H, Eq, A>>
+    {
+        static inline void write(buffer& buf, const std::unordered_map<K, V, H, Eq, A>& value) { detail::write_map(buf, value); }
+        static inline bool read(reader& in, std::unordered_map<K, V, H, Eq, A>& value) { return detail::read_map(in, value); }
+        static inline bool skip(reader& in) { return detail::skip_range<std::pair<K, V>>(in); }
+    };
+
+    template <typename K, typename V, typename H, typename Eq, typename A>
+    struct traits<std::unordered_multimap<K, V, H, Eq, A>>
+    {
+        static inline void write(buffer& buf, const std::unordered_multimap<K, V, H, Eq, A>& value) { detail::write_map(buf, value); }
+        static inline bool read(reader& in, std::unordered_multimap<K, V, H, Eq, A>& value) { return detail::read_map(in, value); }
+        static inline bool skip(reader& in) { return detail::skip_range<std::pair<K, V>>(in); }
+    };
+
+    template <typename T1, typename T2>
+    struct traits<std::pair<T1, T2>>
+    {
+        static inline void write(buffer& buf, const std::pair<T1, T2>& value) {
+            codec::write(buf, value.first);
+            codec::write(buf, value.second);
+        }
+        static inline bool read(reader& in, std::pair<T1, T2>& value) {
+            return codec::read(in, value.first) && codec::read(in, value.second);
+        }
+        static inline bool skip(reader& in) { return codec::skip<T1>(in) && codec::skip<T2>(in); }
+    };
+
+    template <typename... T>
+    struct traits<std::tuple<T...>>
+    {
+        static inline void write(buffer& buf, const std::tuple<T...>& value) { detail::write_tuple(buf, value, std::index_sequence_for<T...>()); }
+        static inline bool read(reader& in, std::tuple<T...>& value) { return detail::read_tuple(in, value, std::index_sequence_for<T...>()); }
+        static inline bool skip(reader& in) { return detail::skip_tuple<std::tuple<T...>>(in, std::index_sequence_for<T...>()); }
+    };
+
+    // inline storage, encoded as std::string and std::vector; longer input than the capacity is rejected
+    template <std::size_t N>
+    struct traits<fixed_string<N>>
+    {
+        static inline void write(buffer& buf, const fixed_string<N>& value) {
+            write_count(buf, value.size());
+            buf.put(value.data(), value.size());
+        }
+        static inline bool read(reader& in, fixed_string<N>& value) {
+            std::size_t count;
+            if (!read_count(in, count) || count > N || count > in.remaining()) {
+                return false;
+            }
+            value.assign(reinterpret_cast<const char*>(in.position()), count);
+            return in.skip(count);
+        }
+        static inline bool skip(reader& in) { return traits<std::string>::skip(in); }
+    };
+
+    template <typename T, std::size_t N>
+    struct traits<static_vector<T, N>>
+    {
+        static inline void write(buffer& buf, const static_vector<T, N>& value) {
+#ifndef GBP_CODEC_BIG_ENDIAN
+            if constexpr (detail::is_trivially_copied<T>) {
+                write_count(buf, value.size());
+                buf.put(value.data(), value.size() * sizeof(T));
+                return;
+            }
+#endif
+            detail::write_range(buf, value);
+        }
+        static inline bool read(reader& in, static_vector<T, N>& value) {
+#ifndef GBP_CODEC_BIG_ENDIAN
+            if constexpr (detail::is_trivially_copied<T>) {
+                std::size_t count;
+                if (!read_count(in, count) || count > N || count > in.remaining() / sizeof(T)) {
+                    return false;
+                }
+                value.resize(count);
+                return in.read(value.data(), count * sizeof(T));
+            }
+#endif
+            return detail::read_sequence(in, value);
+        }
+        static inline bool skip(reader& in) { return detail::skip_range<T>(in); }
+    };
+
+    // fixed size, no count prefix
+    template <typename T, std::size_t N>
+    struct traits<std::array<T, N>>
+    {
+        static inline void write(buffer& buf, const std::array<T, N>& value) {
+            for (const T& item: value) {
+                codec::write(buf, item);
+            }
+        }
+        static inline bool read(reader& in, std::array<T, N>& value) {
+            for (T& item: value) {
+                if (!codec::read(in, item)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        static inline bool skip(reader& in) {
+            for (std::size_t i = 0; i < N; i++) {
+                if (!codec::skip<T>(in)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+namespace detail {
+    template <typename T>
+    constexpr bool is_wire_integer = std::is_integral<T>::value && !std::is_same<T, bool>::value;
+
+    template <typename C> struct is_flat_container : std::false_type {};
+    template <typename T, typename A> struct is_flat_container<std::vector<T, A>> : std::true_type {};
+    template <typename T, typename A> struct is_flat_container<std::deque<T, A>> : std::true_type {};
+    template <typename T, typename A> struct is_flat_container<std::list<T, A>> : std::true_type {};
+    template <typename T, typename Cmp, typename A> struct is_flat_container<std::set<T, Cmp, A>> : std::true_type {};
+    template <typename T, typename Cmp, typename A> struct is_flat_container<std::multiset<T, Cmp, A>> : std::true_type {};
+    template <typename T, typename H, typename Eq, typename A> struct is_flat_container<std::unordered_set<T, H, Eq, A>> : std::true_type {};
+    template <typename T, typename H, typename Eq, typename A> struct is_flat_container<std::unordered_multiset<T, H, Eq, A>> : std::true_type {};
+    template <typename T, std::size_t N> struct is_flat_container<static_vector<T, N>> : std::true_type {};
+
+    template <typename C, typename = void> struct is_integer_container : std::false_type {};
+    template <typename C> struct is_integer_container<C, typename std::enable_if<is_flat_container<C>::value>::type>
+        : std::integral_constant<bool, is_wire_integer<typename C::value_type>> {};
+
+    // the sign bit moves to bit 0, so small negative values stay short
+    template <typename T>
+    inline gbp_u64 zigzag_encode(T value) {
+        using U = typename std::make_unsigned<T>::type;
+        U u = static_cast<U>(value);
+        U sign = (u >> (sizeof(U) * 8 - 1)) != 0 ? static_cast<U>(-1) : U(0);
+        return static_cast<U>(static_cast<U>(u << 1) ^ sign);
+    }
+    template <typename T>
+    inline bool zigzag_decode(gbp_u64 raw, T& value) {
+        using U = typename std::make_unsigned<T>::type;
+        if (raw > static_cast<U>(-1)) {
+            return false;
+        }
+        U z = static_cast<U>(raw);
+        value = static_cast<T>(static_cast<U>((z >> 1) ^ static_cast<U>(-static_cast<U>(z & 1))));
+        return true;
+    }
+} //namespace detail
+
+    template <typename T>
+    struct wire_traits<wire::varint, T, typename std::enable_if<detail::is_wire_integer<T>>::type>
+    {
+        using U = typename std::make_unsigned<T>::type;
+
+        static inline void write(buffer& buf, T value) { write_varint(buf, static_cast<U>(value)); }
+        static inline bool read(reader& in, T& value) {
+            gbp_u64 raw;
+            if (!read_varint(in, raw) || raw > static_cast<U>(-1)) {
+                return false;
+            }
+            value = static_cast<T>(static_cast<U>(raw));
+            return true;
+        }
+        static inline bool skip(reader& in) {
+            T value;
+            return read(in, value);
+        }
+    };
+
+    template <typename T>
+    struct wire_traits<wire::zigzag, T, typename std::enable_if<detail::is_wire_integer<T>>::type>
+    {
+        static inline void write(buffer& buf, T value) { write_varint(buf, detail::zigzag_encode(value)); }
+        static inline bool read(reader& in, T& value) {
+            gbp_u64 raw;
+            return read_varint(in, raw) && detail::zigzag_decode(raw, value);
+        }
+        static inline bool skip(reader& in) {
+            T value;
+            return read(in, value);
+        }
+    };
+
+    // varint and zigzag on a container apply to its elements
+    template <typename Wire, typename C>
+    struct wire_traits<Wire, C, typename std::enable_if<(std::is_same<Wire, wire::varint>::value || std::is_same<Wire, wire::zigzag>::value)
+                                                        && detail::is_integer_container<C>::value>::type>
+    {
+        using T = typename C::value_type;
+
+        static inline void write(buffer& buf, const C& value) {
+            write_count(buf, value.size());
+            for (T item: value) {
+                write_as<Wire>(buf, item);
+            }
+        }
+        static inline bool read(reader& in, C& value) {
+            std::size_t count;
+            if (!read_count(in, count) || count > value.max_size()) {
+                return false;
+            }
+            value.clear();
+            detail::reserve(value, count, in);
+            for (std::size_t i = 0; i < count; i++) {
+                T item;
+                if (!read_as<Wire>(in, item)) {
+                    return false;
+                }
+                value.insert(value.end(), item);
+            }
+            return true;
+        }
+        static inline bool skip(reader& in) {
+            std::size_t count;
+            if (!read_count(in, count)) {
+                return false;
+            }
+            for (std::size_t i = 0; i < count; i++) {
+                if (!skip_as<Wire, T>(in)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    // differences are taken modulo 2^N, so any sequence round-trips; sorted or slowly changing ones get short
+    template <typename C>
+    struct wire_traits<wire::delta, C, typename std::enable_if<detail::is_integer_container<C>::value>::type>
+    {
+        using T = typename C::value_type;
+        using U = typename std::make_unsigned<T>::type;
+
+        static inline void write(buffer& buf, const C& value) {
+            write_count(buf, value.size());
+            U prev = 0;
+            for (T item: value) {
+                U curr = static_cast<U>(item);
+                write_varint(buf, detail::zigzag_encode(static_cast<U>(curr - prev)));
+                prev = curr;
+            }
+        }
+        static inline bool read(reader& in, C& value) {
+            std::size_t count;
+            if (!read_count(in, count) || count > value.max_size()) {
+                return false;
+            }
+            value.clear();
+            detail::reserve(value, count, in);
+            U prev = 0;
+            for (std::size_t i = 0; i < count; i++) {
+                gbp_u64 raw;
+                U diff;
+                if (!read_varint(in, raw) || !detail::zigzag_decode(raw, diff)) {
+                    return false;
+                }
+                prev = static_cast<U>(prev + diff);
+                value.insert(value.end(), static_cast<T>(prev));
+            }
+            return true;
+        }
+        static inline bool skip(reader& in) {
+            std::size_t count;
+            if (!read_count(in, count)) {
+                return false;
+            }
+            for (std::size_t i = 0; i < count; i++) {
+                gbp_u64 raw;
+                if (!read_varint(in, raw)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    // schema fingerprints of member types, composed at compile time so that types declared in other headers
+    // contribute: generated structs through schema_fingerprint, generated enums through
+    //   std::integral_constant<gbp_u64, F> gbp_schema_fingerprint(E);  declared next to the enum, never defined
+    // templates fold the fingerprints of their arguments, anything else is 0
+
+    /** FNV-1a over the 8 bytes of value */
+    constexpr gbp_u64 fingerprint_mix(gbp_u64 h, gbp_u64 value) {
+        for (int i = 0; i < 8; i++) {
+            h ^= (value >> (8 * i)) & 0xffu;
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+namespace detail {
+    template <typename T, typename = void> struct has_schema_fingerprint : std::false_type {};
+    template <typename T> struct has_schema_fingerprint<T, std::void_t<decltype(T::schema_fingerprint)>> : std::true_type {};
+
+    template <typename T, typename = void> struct has_adl_schema_fingerprint : std::false_type {};
+    template <typename T> struct has_adl_schema_fingerprint<T, std::void_t<decltype(gbp_schema_fingerprint(std::declval<T>()))>> : std::true_type {};
+} //namespace detail
+
+    template <typename T>
+    struct schema_fingerprint_of
+    {
+        static constexpr gbp_u64 value() {
+            if constexpr (detail::has_schema_fingerprint<T>::value) {
+                return T::schema_fingerprint;
+            } else if constexpr (detail::has_adl_schema_fingerprint<T>::value) {
+                return decltype(gbp_schema_fingerprint(std::declval<T>()))::value;
+            } else {
+                return 0;
+            }
+        }
+    };
+
+    template <template <typename...> class C, typename... Args>
+    struct schema_fingerprint_of<C<Args...>>
+    {
+        static constexpr gbp_u64 value() {
+            gbp_u64 h = 14695981039346656037ull;
+            ((h = fingerprint_mix(h, schema_fingerprint_of<Args>::value())), ...);
+            return h;
+        }
+    };
+
+    /** std::array, gbp::static_vector */
+    template <template <typename, std::size_t> class C, typename T, std::size_t N>
+    struct schema_fingerprint_of<C<T, N>>
+    {
+        static constexpr gbp_u64 value() { return schema_fingerprint_of<T>::value(); }
+    };
+
+    // messages: the schema fingerprint of the type followed by its encoding,
+    // a peer built from other declarations rejects them before decoding any member
+    enum class message_status
+    {
+        ok,
+        schema_mismatch,
+        invalid
+    };
+
+    template <typename T>
+    inline void encode_message(buffer& buf, const T& value) {
+        write_fixed(buf, T::schema_fingerprint);
+        value.encode(buf);
+    }
+
+    /** false if data is too short to hold one */
+    inline bool message_fingerprint(byte_span data, gbp_u64& fingerprint) {
+        reader in(data);
+        return read_fixed(in, fingerprint);
+    }
+
+    /** value is left untouched unless the fingerprint matches, the whole input must be consumed */
+    template <typename T>
+    inline message_status decode_message(byte_span data, T& value) {
+        reader in(data);
+        gbp_u64 fingerprint;
+        if (!read_fixed(in, fingerprint)) {
+            return message_status::invalid;
+        }
+        if (fingerprint != T::schema_fingerprint) {
+            return message_status::schema_mismatch;
+        }
+        return value.decode(in) && in.at_end() ? message_status::ok : message_status::invalid;
+    }
+} //namespace codec
+} //namespace gbp)";
+
+constexpr static const char* runtimeView =
+R"(#pragma once
+#include "gbp_codec.hpp"
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+
+// Read-only access to encoded GBP types without decoding them.
+// Strings are std::string_view into the buffer, nested types and containers are views again,
+// everything else, and members with a wire annotation, are decoded on access. The buffer must outlive its views.
+namespace gbp {
+    template <typename T, typename Enable = void>
+    struct view_traits
+    {
+        using type = T;
+        static inline type make(byte_span data) {
+            T value{};
+            reader in(data);
+            codec::read(in, value);
+            return value;
+        }
+    };
+
+    template <typename T, typename Wire = wire::fixed>
+    using view_t = typename std::conditional<std::is_same<Wire, wire::fixed>::value, typename view_traits<T>::type, T>::type;
+
+    template <typename T, typename Wire = wire::fixed>
+    inline view_t<T, Wire> make_view(byte_span data) {
+        if constexpr (std::is_same<Wire, wire::fixed>::value) {
+            return view_traits<T>::make(data);
+        } else {
+            T value{};
+            reader in(data);
+            codec::read_as<Wire>(in, value);
+            return value;
+        }
+    }
+
+    // elements of an encoded container, the element boundaries are found by skipping
+    template <typename T>
+    class sequence_view
+    {
+        byte_span m_data;
+        std::size_t m_size;
+    public:
+        class iterator
+        {
+            const unsigned char* m_pos;
+            const unsigned char* m_end;
+
+            inline const unsigned char* next() const {
+                reader in(byte_span(m_pos, static_cast<std::size_t>(m_end - m_pos)));
+                return codec::skip<T>(in) ? in.position() : m_end;
+            }
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = view_t<T>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = value_type;
+
+            iterator(const unsigned char* pos, const unsigned char* end) : m_pos(pos), m_end(end) {}
+
+            inline value_type operator*() const { return make_view<T>(byte_span(m_pos, static_cast<std::size_t>(next() - m_pos))); }
+            inline iterator& operator++() { m_pos = next(); return *this; }
+            inline iterator operator++(int) { iterator it = *this; m_pos = next(); return it; }
+            inline bool operator==(const iterator& other) const { return m_pos == other.m_pos; }
+            inline bool operator!=(const iterator& other) const { return m_pos != other.m_pos; }
+        };
+
+        sequence_view() : m_data(), m_size(0) {}
+        sequence_view(byte_span data, std::size_t size) : m_data(data), m_size(size) {}
+
+        inline std::size_t size() const { return m_size; }
+        inline bool empty() const { return m_size == 0; }
+        inline iterator begin() const { return iterator(m_data.data, m_data.data + m_data.size); }
+        inline iterator end() const { return iterator(m_data.data + m_data.size, m_data.data + m_data.size); }
+
+        // O(1) for fixed width elements, walks the preceding elements otherwise
+        inline view_t<T> operator[](std::size_t i) const {
+            if constexpr (codec::detail::is_trivially_copied<T>) {
+                return make_view<T>(byte_span(m_data.data + i * sizeof(T), sizeof(T)));
+            } else {
+                iterator it = begin();
+                for (; i > 0; i--) {
+                    ++it;
+                }
+                return *it;
+            }
+        }
+    };
+
+namespace detail {
+    template <typename T>
+    struct sequence_view_traits
+    {
+        using type = sequence_view<T>;
+        static inline type make(byte_span data) {
+            reader in(data);
+            std::size_t count;
+            if (!codec::read_count(in, count)) {
+                return type();
+            }
+            return type(byte_span(in.position(), in.remaining()), count);
+        }
+    };
+
+    template <typename T, std::size_t N, std::size_t... I>
+    inline bool scan_members(byte_span& data, std::array<std::size_t, N>& offsets, std::index_sequence<I...>) {
+        reader in(data);
+        bool ok = ((offsets[I] = static_cast<std::size_t>(in.position() - data.data),
+                    codec::skip_as<codec::member_wire_t<T, I>, typename std::tuple_element<I, typename T::types_as_tuple>::type>(in)) && ...);
+        if (!ok) {
+            offsets.fill(0);
+            data.size = 0;
+            return false;
+        }
+        offsets[N - 1] = static_cast<std::size_t>(in.position() - data.data);
+        data.size = offsets[N - 1];
+        return true;
+    }
+} //namespace detail
+
+    // offsets of every member plus the end, data is cut down to the bytes of the object
+    template <typename T, std::size_t N>
+    inline bool scan_members(byte_span& data, std::array<std::size_t, N>& offsets) {
+        return detail::scan_members<T>(data, offsets, std::make_index_sequence<N - 1>());
+    }
+
+    template <typename Tr, typename A>
+    struct view_traits<std::basic_string<char, Tr, A>>
+    {
+        using type = std::string_view;
+        static inline type make(byte_span data) {
+            reader in(data);
+            std::size_t count;
+            if (!codec::read_count(in, count) || count > in.remaining()) {
+                return type();
+            }
+            return type(reinterpret_cast<const char*>(in.position()), count);
+        }
+    };
+
+namespace detail {
+    // generated next to the type, found by ADL
+    template <typename T, typename = void> struct has_view_type : std::false_type {};
+    template <typename T> struct has_view_type<T, std::void_t<decltype(gbp_view_type(std::declval<const T&>()))>> : std::true_type {};
+} //namespace detail
+
+    // GBP types, the view class is generated
+    template <typename T>
+    struct view_traits<T, typename std::enable_if<detail::has_view_type<T>::value>::type>
+    {
+        using type = decltype(gbp_view_type(std::declval<const T&>()));
+        static inline type make(byte_span data) { return type(data); }
+    };
+
+    template <typename T1, typename T2>
+    struct view_traits<std::pair<T1, T2>>
+    {
+        using type = std::pair<view_t<T1>, view_t<T2>>;
+        static inline type make(byte_span data) {
+            reader in(data);
+            if (!codec::skip<T1>(in)) {
+                return type();
+            }
+            std::size_t first = static_cast<std::size_t>(in.position() - data.data);
+            return type(make_view<T1>(byte_span(data.data, first)), make_view<T2>(byte_span(in.position(), in.remaining())));
+        }
+    };
+
+    template <typename T, typename A> struct view_traits<std::vector<T, A>> : detail::sequence_view_traits<T> {};
+    template <typename T, typename A> struct view_traits<std::deque<T, A>> : detail::sequence_view_traits<T> {};
+    template <typename T, typename A> struct view_traits<std::list<T, A>> : detail::sequence_view_traits<T> {};
+    template <typename T, typename Cmp, typename A> struct view_traits<std::set<T, Cmp, A>> : detail::sequence_view_traits<T> {};
+    template <typename T, typename Cmp, typename A> struct view_traits<std::multiset<T, Cmp, A>> : detail::sequence_view_traits<T> {};
+    template <typename T, typename H, typename Eq, typename A> struct view_traits<std::unordered_set<T, H, Eq, A>> : detail::sequence_view_traits<T> {};
+    template <typename T, typename H, typename Eq, typename A> struct view_traits<std::unordered_multiset<T, H, Eq, A>> : detail::sequence_view_traits<T> {};
+    template <typename K, typename V, typename Cmp, typename A> struct view_traits<std::map<K, V, Cmp, A>> : detail::sequence_view_traits<std::pair<K, V>> {};
+    template <typename K, typename V, typename Cmp, typename A> struct view_traits<std::multimap<K, V, Cmp, A>> : detail::sequence_view_traits<std::pair<K, V>> {};
+    template <typename K, typename V, typename H, typename Eq, typename A> struct view_traits<std::unordered_map<K, V, H, Eq, A>> : detail::sequence_view_traits<std::pair<K, V>> {};
+    template <typename K, typename V, typename H, typename Eq, typename A> struct view_traits<std::unordered_multimap<K, V, H, Eq, A>> : detail::sequence_view_traits<std::pair<K, V>> {};
+} //namespace gbp
+)";
+
+constexpr static const char* runtimeJson =
+R"(#pragma once
+#include "gbp_int.hpp"
+#include "gbp_alloc.hpp"
+#include "gbp_fixed.hpp"
+#include "gbp_hash.hpp"
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <locale>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// JSON input and output of GBP types, without iostreams, locale or a DOM.
+// Output is appended to one std::string, input is parsed in a single pass straight into the destination.
+// Enums are written as their full name (enum_cast) and read by full or short name (enum_from_string),
+// map keys are strings, types without a JSON mapping are written through std::quoting and cannot be read.
+namespace gbp {
+namespace json {
+    class writer
+    {
+        std::string m_own;
+        std::string& m_out;
+    public:
+        writer() : m_own(), m_out(m_own) {}
+        /** appends to a buffer owned by the caller, it can be reused between objects */
+        explicit writer(std::string& out) : m_own(), m_out(out) {}
+
+        writer(const writer&) = delete;
+        writer& operator=(const writer&) = delete;
+
+        inline const char* data() const { return m_out.data(); }
+        inline std::size_t size() const { return m_out.size(); }
+        inline const std::string& str() const { return m_out; }
+        inline void clear() { m_out.clear(); }
+        inline void reserve(std::size_t size) { m_out.reserve(size); }
+
+        inline void put(char c) { m_out.push_back(c); }
+        inline void put(const char* data, std::size_t size) { m_out.append(data, size); }
+        // string literal with its length known at compile time, used for the generated keys
+        template <std::size_t N>
+        inline void literal(const char (&str)[N]) { m_out.append(str, N - 1); }
+
+        inline void null() { literal("null"); }
+        inline void boolean(bool value) { value ? literal("true") : literal("false"); }
+
+        template <typename T>
+        inline void integer(T value) {
+            char buf[24];
+            char* end = buf + sizeof(buf);
+            char* p = end;
+            using U = typename std::make_unsigned<T>::type;
+            U u = static_cast<U>(value);
+            bool negative = std::is_signed<T>::value && value < 0;
+            if (negative) {
+                u = static_cast<U>(U(0) - u);
+            }
+            static const char digits[] =
+                "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                "8081828384858687888990919293949596979899";
+            while (u >= 100) {
+                unsigned i = static_cast<unsigned>(u % 100) * 2;
+                u = static_cast<U>(u / 100);
+                *--p = digits[i + 1];
+                *--p = digits[i];
+            }
+            if (u >= 10) {
+                unsigned i = static_cast<unsigned>(u) * 2;
+                *--p = digits[i + 1];
+                *--p = digits[i];
+            } else {
+                *--p = static_cast<char>('0' + u);
+            }
+            if (negative) {
+                *--p = '-';
+            }
+            put(p, static_cast<std::size_t>(end - p));
+        }
+
+        // shortest representation that reads back to the same value, non-finite values are null
+        template <typename T>
+        inline void floating(T value) {
+            if (!std::isfinite(value)) {
+                null();
+                return;
+            }
+            char buf[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            std::to_chars_result res = std::to_chars(buf, buf + sizeof(buf), value);
+            put(buf, static_cast<std::size_t>(res.ptr - buf));
+#else
+            int len = std::snprintf(buf, sizeof(buf), "%.17g", static_cast<double>(value));
+            for (int i = 0; i < len; i++) {
+                if (buf[i] == ',') {
+                    buf[i] = '.';   // decimal comma locales
+                }
+            }
+            put(buf, static_cast<std::size_t>(len));
+#endif
+        }
+
+        inline void string(std::string_view str) {
+            static const char hex[] = "0123456789abcdef";
+            put('"');
+            const char* begin = str.data();
+            const char* end = begin + str.size();
+            const char* run = begin;
+            for (const char* p = begin; p != end; ++p) {
+                unsigned char c = static_cast<unsigned char>(*p);
+                if (c >= 0x20 && c != '"' && c != '\\') {
+                    continue;
+                }
+                put(run, static_cast<std::size_t>(p - run));
+                run = p + 1;
+                switch (c) {
+                case '"':  literal("\\\""); break;
+                case '\\': literal("\\\\"); break;
+                case '\n': literal("\\n"); break;
+                case '\r': literal("\\r"); break;
+                case '\t': literal("\\t"); break;
+                case '\b': literal("\\b"); break;
+                case '\f': literal("\\f"); break;
+                default: {
+                    char esc[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 15]};
+                    put(esc, sizeof(esc));
+                }
+                }
+            }
+            put(run, static_cast<std::size_t>(end - run));
+            put('"');
+        }
+    };
+
+    // single pass pull parser over the whole text, keys are returned as views and never allocated
+    class reader
+    {
+        const char* m_pos;
+        const char* m_end;
+        int m_depth;
+        std::array<char, 64> m_key; // unescaped keys, longer escaped keys match nothing
+    public:
+        static constexpr int max_depth = 256;
+
+        explicit reader(std::string_view text) : m_pos(text.data()), m_end(text.data() + text.size()), m_depth(0), m_key() {}
+
+        inline std::size_t offset(const char* begin) const { return static_cast<std::size_t>(m_pos - begin); }
+
+        inline void skip_ws() {
+            while (m_pos != m_end && (*m_pos == ' ' || *m_pos == '\n' || *m_pos == '\r' || *m_pos == '\t')) {
+                ++m_pos;
+            }
+        }
+        inline bool peek(char& c) {
+            skip_ws();
+            if (m_pos == m_end) {
+                return false;
+            }
+            c = *m_pos;
+            return true;
+        }
+        inline bool consume(char c) {
+            skip_ws();
+            if (m_pos != m_end && *m_pos == c) {
+                ++m_pos;
+                return true;
+            }
+            return false;
+        }
+        /** only whitespace may follow the value */
+        inline bool finish() {
+            skip_ws();
+            return m_pos == m_end;
+        }
+
+        inline bool read_word(std::string_view word) {
+            skip_ws();
+            if (static_cast<std::size_t>(m_end - m_pos) >= word.size() && std::memcmp(m_pos, word.data(), word.size()) == 0) {
+                m_pos += word.size();
+                return true;
+            }
+            return false;
+        }
+        inline bool read_null() { return read_word("null"); }
+        inline bool read_bool(bool& value) {
+            if (read_word("true")) {
+                value = true;
+                return true;
+            }
+            if (read_word("false")) {
+                value = false;
+                return true;
+            }
+            return false;
+        }
+
+        // span of a JSON number, checked by the conversion
+        inline std::string_view number_text() {
+            skip_ws();
+            const char* begin = m_pos;
+            while (m_pos != m_end && ((*m_pos >= '0' && *m_pos <= '9') || *m_pos == '-' || *m_pos == '+' || *m_pos == '.' || *m_pos == 'e' || *m_pos == 'E')) {
+                ++m_pos;
+            }
+            return std::string_view(begin, static_cast<std::size_t>(m_pos - begin));
+        }
+        template <typename T>
+        inline bool read_integer(T& value) {
+            std::string_view text = number_text();
+            std::from_chars_result res = std::from_chars(text.data(), text.data() + text.size(), value);
+            return !text.empty() && res.ec == std::errc() && res.ptr == text.data() + text.size();
+        }
+        template <typename T>
+        inline bool read_floating(T& value) {
+            std::string_view text = number_text();
+            if (text.empty()) {
+                return false;
+            }
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            std::from_chars_result res = std::from_chars(text.data(), text.data() + text.size(), value);
+            return res.ec == std::errc() && res.ptr == text.data() + text.size();
+#else
+            std::istringstream is(std::string(text));
+            is.imbue(std::locale::classic());
+            is >> value;
+            return !is.fail() && is.peek() == std::char_traits<char>::eof();
+#endif
+        }
+
+        /** unescapes into out, which keeps its capacity and allocator; fails beyond out.max_size() */
+        template <typename S>
+        inline bool read_string(S& out) {
+            out.clear();
+            return read_string_impl([&out](const char* data, std::size_t size) {
+                if (size > out.max_size() - out.size()) {
+                    return false;
+                }
+                out.append(data, size);
+                return true;
+            });
+        }
+        /** a view into the text when there are no escapes, otherwise into a small internal buffer */
+        inline bool read_key(std::string_view& key) {
+            skip_ws();
+            if (m_pos == m_end || *m_pos != '"') {
+                return false;
+            }
+            const char* begin = m_pos + 1;
+            const char* p = begin;
+            while (p != m_end && *p != '"' && *p != '\\') {
+                ++p;
+            }
+            if (p != m_end && *p == '"') {
+                key = std::string_view(begin, static_cast<std::size_t>(p - begin));
+                m_pos = p + 1;
+                return true;
+            }
+            std::size_t size = 0;
+            bool fits = true;
+            bool ok = read_string_impl([&](const char* data, std::size_t n) {
+                if (size + n > m_key.size()) {
+                    fits = false;
+                } else {
+                    std::memcpy(m_key.data() + size, data, n);
+                    size += n;
+                }
+                return true;
+            });
+            key = fits ? std::string_view(m_key.data(), size) : std::string_view();
+            return ok;
+        }
+
+        // calls on_member(reader&, std::string_view key) for every member, it must consume the value
+        template <typename F>
+        inline bool read_object(F&& on_member) {
+            if (!consume('{') || !enter()) {
+                return false;
+            }
+            if (consume('}')) {
+                return leave();
+            }
+            do {
+                std::string_view key;
+                if (!read_key(key) || !consume(':') || !on_member(*this, key)) {
+                    return false;
+                }
+            } while (consume(','));
+            return consume('}') && leave();
+        }
+        // calls on_item(reader&) for every element, it must consume the value
+        template <typename F>
+        inline bool read_array(F&& on_item) {
+            if (!consume('[') || !enter()) {
+                return false;
+            }
+            if (consume(']')) {
+                return leave();
+            }
+            do {
+                if (!on_item(*this)) {
+                    return false;
+                }
+            } while (consume(','));
+            return consume(']') && leave();
+        }
+
+        inline bool skip_value() {
+            char c;
+            if (!peek(c)) {
+                return false;
+            }
+            switch (c) {
+            case '{':
+                return read_object([](reader& r, std::string_view) { return r.skip_value(); });
+            case '[':
+                return read_array([](reader& r) { return r.skip_value(); });
+            case '"':
+                return read_string_impl([](const char*, std::size_t) { return true; });
+            case 't':
+            case 'f': {
+                bool value;
+                return read_bool(value);
+            }
+            case 'n':
+                return read_null();
+            default: {
+                double value;
+                return read_floating(value);
+            }
+            }
+        }
+    private:
+        inline bool enter() { return ++m_depth <= max_depth; }
+        inline bool leave() { --m_depth; return true; }
+
+        static inline int hex_digit(char c) {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+        inline bool read_hex4(gbp_u32& cp) {
+            if (m_end - m_pos < 4) {
+                return false;
+            }
+            cp = 0;
+            for (int i = 0; i < 4; i++) {
+                int d = hex_digit(*m_pos++);
+                if (d < 0) {
+                    return false;
+                }
+                cp = (cp << 4) | static_cast<gbp_u32>(d);
+            }
+            return true;
+        }
+
+        // feeds unescaped runs to sink(const char*, size), which returns false to stop
+        template <typename Sink>
+        inline bool read_string_impl(Sink&& sink) {
+            skip_ws();
+            if (m_pos == m_end || *m_pos != '"') {
+                return false;
+            }
+            ++m_pos;
+            const char* run = m_pos;
+            while (m_pos != m_end) {
+                char c = *m_pos;
+                if (c == '"') {
+                    ++m_pos;
+                    return sink(run, static_cast<std::size_t>(m_pos - 1 - run));
+                }
+                if (c != '\\') {
+                    ++m_pos;
+                    continue;
+                }
+                if (!sink(run, static_cast<std::size_t>(m_pos - run)) || ++m_pos == m_end) {
+                    return false;
+                }
+                char esc = *m_pos++;
+                char ch;
+                switch (esc) {
+                case '"':  ch = '"';  break;
+                case '\\': ch = '\\'; break;
+                case '/':  ch = '/';  break;
+                case 'b':  ch = '\b'; break;
+                case 'f':  ch = '\f'; break;
+                case 'n':  ch = '\n'; break;
+                case 'r':  ch = '\r'; break;
+                case 't':  ch = '\t'; break;
+                case 'u': {
+                    gbp_u32 cp;
+                    if (!read_hex4(cp)) {
+                        return false;
+                    }
+                    if (cp >= 0xd800 && cp < 0xdc00) {
+                        gbp_u32 low;
+                        if (m_end - m_pos < 6 || m_pos[0] != '\\' || m_pos[1] != 'u') {
+                            return false;
+                        }
+                        m_pos += 2;
+                        if (!read_hex4(low) || low < 0xdc00 || low >= 0xe000) {
+                            return false;
+                        }
+                        cp = 0x10000 + ((cp - 0xd800) << 10) + (low - 0xdc00);
+                    }
+                    char utf8[4];
+                    std::size_t n;
+                    if (cp < 0x80) {
+                        utf8[0] = static_cast<char>(cp);
+                        n = 1;
+                    } else if (cp < 0x800) {
+                        utf8[0] = static_cast<char>(0xc0 | (cp >> 6));
+                        utf8[1] = static_cast<char>(0x80 | (cp & 0x3f));
+                        n = 2;
+                    } else if (cp < 0x10000) {
+                        utf8[0] = static_cast<char>(0xe0 | (cp >> 12));
+                        utf8[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+                        utf8[2] = static_cast<char>(0x80 | (cp & 0x3f));
+                        n = 3;
+                    } else {
+                        utf8[0] = static_cast<char>(0xf0 | (cp >> 18));
+                        utf8[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3f));
+                        utf8[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+                        utf8[3] = static_cast<char>(0x80 | (cp & 0x3f));
+                        n = 4;
+                    }
+                    if (!sink(utf8, n)) {
+                        return false;
+                    }
+                    run = m_pos;
+                    continue;
+                }
+                default:
+                    return false;
+                }
+                if (!sink(&ch, 1)) {
+                    return false;
+                }
+                run = m_pos;
+            }
+            return false;
+        }
+    };
+
+    template <typename T, typename Enable = void>
+    struct traits; // types without a JSON mapping, written through std::quoting and never read
+
+    template <typename T> inline void write(writer& w, const T& value) { traits<T>::write(w, value); }
+    /** null keeps the current value */
+    template <typename T> inline bool read(reader& r, T& value) { return r.read_null() || traits<T>::read(r, value); }
+
+namespace detail {
+    template <typename T, typename = void> struct has_to_json : std::false_type {};
+    template <typename T> struct has_to_json<T, std::void_t<decltype(std::declval<const T&>().to_json(std::declval<writer&>()))>> : std::true_type {};
+
+    template <typename T, typename = void> struct has_enum_cast : std::false_type {};
+    template <typename T> struct has_enum_cast<T, std::void_t<decltype(enum_cast(std::declval<T>(), true))>> : std::true_type {};
+
+    template <typename T, typename = void> struct has_enum_from_string : std::false_type {};
+    template <typename T> struct has_enum_from_string<T, std::void_t<decltype(enum_from_string(std::string_view(), std::declval<T&>()))>> : std::true_type {};
+
+    template <typename C>
+    inline void write_array(writer& w, const C& c) {
+        w.put('[');
+        bool first = true;
+        for (const auto& item: c) {
+            if (!first) {
+                w.put(',');
+            }
+            first = false;
+            write(w, item);
+        }
+        w.put(']');
+    }
+
+    template <typename K>
+    inline void write_key(writer& w, const K& key) {
+        if constexpr (std::is_convertible<const K&, std::string_view>::value) {
+            w.string(key);
+        } else if constexpr (std::is_arithmetic<K>::value && !std::is_same<K, bool>::value) {
+            w.put('"');
+            write(w, key);
+            w.put('"');
+        } else {
+            writer tmp;
+            write(tmp, key);
+            if (!tmp.str().empty() && tmp.str().front() == '"') {
+                w.put(tmp.data(), tmp.size());
+            } else {
+                w.string(tmp.str());
+            }
+        }
+    }
+
+    template <typename C>
+    inline void write_object(writer& w, const C& c) {
+        w.put('{');
+        bool first = true;
+        for (const auto& item: c) {
+            if (!first) {
+                w.put(',');
+            }
+            first = false;
+            write_key(w, item.first);
+            w.put(':');
+            write(w, item.second);
+        }
+        w.put('}');
+    }
+
+    template <typename T, std::size_t... N>
+    inline void write_tuple(writer& w, const T& value, std::index_sequence<N...>) {
+        w.put('[');
+        ((N == 0 ? void() : w.put(','), write(w, std::get<N>(value))), ...);
+        w.put(']');
+    }
+
+    // existing elements are read in place, so strings inside keep their buffers
+    template <typename C>
+    inline bool read_sequence(reader& r, C& c) {
+        auto it = c.begin();
+        bool ok = r.read_array([&](reader& in) {
+            if (it == c.end()) {
+                if (c.size() == c.max_size()) {
+                    return false;
+                }
+                c.emplace_back();
+                it = std::prev(c.end());
+            }
+            return read(in, *it++);
+        });
+        c.erase(it, c.end());
+        return ok;
+    }
+
+    template <typename C>
+    inline bool read_set(reader& r, C& c) {
+        c.clear();
+        return r.read_array([&](reader& in) {
+            auto item = make_element<typename C::value_type>(c);
+            if (!read(in, item)) {
+                return false;
+            }
+            c.insert(c.end(), std::move(item));
+            return true;
+        });
+    }
+
+    template <typename K>
+    inline bool read_key(std::string_view text, K& key) {
+        if constexpr (std::is_constructible<K, std::string_view>::value) {
+            key = K(text);
+            return true;
+        } else if constexpr (std::is_integral<K>::value && !std::is_same<K, bool>::value) {
+            std::from_chars_result res = std::from_chars(text.data(), text.data() + text.size(), key);
+            return !text.empty() && res.ec == std::errc() && res.ptr == text.data() + text.size();
+        } else if constexpr (std::is_enum<K>::value && has_enum_from_string<K>::value) {
+            return enum_from_string(text, key);
+        } else {
+            return false;
+        }
+    }
+
+    template <typename C>
+    inline bool read_object(reader& r, C& c) {
+        c.clear();
+        return r.read_object([&](reader& in, std::string_view text) {
+            auto key = make_element<typename C::key_type>(c);
+            auto value = make_element<typename C::mapped_type>(c);
+            if (!read_key(text, key) || !read(in, value)) {
+                return false;
+            }
+            c.emplace_hint(c.end(), std::move(key), std::move(value));
+            return true;
+        });
+    }
+
+    template <typename T, std::size_t... N>
+    inline bool read_tuple(reader& r, T& value) {
+        std::size_t i = 0;
+        bool ok = r.read_array([&](reader& in) {
+            bool res = false;
+            ((i == N ? (res = read(in, std::get<N>(value)), true) : false) || ...);
+            return i++ < sizeof...(N) && res;
+        });
+        return ok && i == sizeof...(N);
+    }
+    template <typename T, std::size_t... N>
+    inline bool read_tuple(reader& r, T& value, std::index_sequence<N...>) {
+        return read_tuple<T, N...>(r, value);
+    }
+} //namespace detail
+
+    template <typename T, typename Enable>
+    struct traits
+    {
+        static inline void write(writer& w, const T& value) {
+            std::ostringstream os;
+            std::quoting(os, value);
+            w.put(os.str().data(), os.str().size());
+        }
+        static inline bool read(reader& r, T&) {
+            r.skip_value();
+            return false;
+        }
+    };
+
+    template <>
+    struct traits<bool>
+    {
+        static inline void write(writer& w, bool value) { w.boolean(value); }
+        static inline bool read(reader& r, bool& value) { return r.read_bool(value); }
+    };
+
+    template <typename T>
+    struct traits<T, typename std::enable_if<std::is_integral<T>::value>::type>
+    {
+        static inline void write(writer& w, T value) { w.integer(value); }
+        static inline bool read(reader& r, T& value) { return r.read_integer(value); }
+    };
+
+    template <typename T>
+    struct traits<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+    {
+        static inline void write(writer& w, T value) { w.floating(value); }
+        static inline bool read(reader& r, T& value) { return r.read_floating(value); }
+    };
+
+    template <typename T>
+    struct traits<T, typename std::enable_if<std::is_enum<T>::value>::type>
+    {
+        using underlying = typename std::underlying_type<T>::type;
+
+        static inline void write(writer& w, T value) {
+            if constexpr (detail::has_enum_cast<T>::value) {
+                w.string(enum_cast(value, true));
+            } else {
+                w.integer(static_cast<underlying>(value));
+            }
+        }
+        // by name, or by value
+        static inline bool read(reader& r, T& value) {
+            char c;
+            if (!r.peek(c)) {
+                return false;
+            }
+            if (c == '"') {
+                std::string_view name;
+                if constexpr (detail::has_enum_from_string<T>::value) {
+                    return r.read_key(name) && enum_from_string(name, value);
+                } else {
+                    return false;
+                }
+            }
+            underlying raw;
+            if (!r.read_integer(raw)) {
+                return false;
+            }
+            value = static_cast<T>(raw);
+            return true;
+        }
+    };
+
+    // GBP types, to_json and from_json are generated
+    template <typename T>
+    struct traits<T, typename std::enable_if<detail::has_to_json<T>::value>::type>
+    {
+        static inline void write(writer& w, const T& value) { value.to_json(w); }
+        static inline bool read(reader& r, T& value) { return value.from_json(r); }
+    };
+
+    template <typename Tr, typename A>
+    struct traits<std::basic_string<char, Tr, A>>
+    {
+        static inline void write(writer& w, const std::basic_string<char, Tr, A>& value) { w.string(std::string_view(value.data(), value.size())); }
+        static inline bool read(reader& r, std::basic_string<char, Tr, A>& value) {
+            value.clear();
+            return r.read_string(value);
+        }
+    };
+
+    template <typename T, typename A>
+    struct traits<std::vector<T, A>>
+    {
+        static inline void write(writer& w, const std::vector<T, A>& value) { detail::write_array(w, value); }
+        static inline bool read(reader& r, std::vector<T, A>& value) { return detail::read_sequence(r, value); }
+    };
+    // bit proxies cannot be read in place
+    template <typename A>
+    struct traits<std::vector<bool, A>>
+    {
+        static inline void write(writer& w, const std::vector<bool, A>& value) { detail::write_array(w, value); }
+        static inline bool read(reader& r, std::vector<bool, A>& value) {
+            value.clear();
+            return r.read_array([&](reader& in) {
+                bool item = false;
+                if (!json::read(in, item)) {
+                    return false;
+                }
+                value.push_back(item);
+                return true;
+            });
+        }
+    };
+    template <std::size_t N>
+    struct traits<fixed_string<N>>
+    {
+        static inline void write(writer& w, const fixed_string<N>& value) { w.string(value.view()); }
+        static inline bool read(reader& r, fixed_string<N>& value) { return r.read_string(value); }
+    };
+    template <typename T, std::size_t N>
+    struct traits<static_vector<T, N>>
+    {
+        static inline void write(writer& w, const static_vector<T, N>& value) { detail::write_array(w, value); }
+        static inline bool read(reader& r, static_vector<T, N>& value) { return detail::read_sequence(r, value); }
+    };
+    template <typename T, typename A>
+    struct traits<std::deque<T, A>>
+    {
+        static inline void write(writer& w, const std::deque<T, A>& value) { detail::write_array(w, value); }
+        static inline bool read(reader& r, std::deque<T, A>& value) { return detail::read_sequence(r, value); }
+    };
+    template <typename T, typename A>
+    struct traits<std::list<T, A>>
+    {
+        static inline void write(writer& w, const std::list<T, A>& value) { detail::write_array(w, value); }
+        static inline bool read(reader& r, std::list<T, A>& value) { return detail::read_sequence(r, value); }
+    };
+    template <typename T, std::size_t N>
+    struct traits<std::array<T, N>>
+    {
+        static inline void write(writer& w, const std::array<T, N>& value) { detail::write_array(w, value); }
+        static inline bool read(reader& r, std::array<T, N>& value) { return detail::read_tuple(r, value, std::make_index_sequence<N>()); }
+    };
+    template <typename T, typename Cmp, typename A>
+    struct traits<std::set<T, Cmp, A>>
+    {
+        static inline void write(writer& w, const std::set<T, Cmp, A>& value) { detail::write_array(w, value); }
+        static inline bool read(reader& r, std::set<T, Cmp, A>& value) { return detail::read_set(r, value); }
+    };
+    template <typename T, typename Cmp, typename A>
+    struct traits<std::multiset<T, Cmp, A>>
+    {
+        static inline void write(writer& w, const std::multiset<T, Cmp, A>& value) { detail::write_array(w, value); }
+        static inline bool read(reader& r, std::multiset<T, Cmp, A>& value) { return detail::read_set(r, value); }
+    };
+    template <typename T, typename H, typename Eq, typename A>
+    struct traits<std::unordered_set<T, H, Eq, A>>
+    {
+        static inline void write(writer& w, const std::unordered_set<T, H, Eq, A>& value) { detail::write_array(w, value); }
+        static inline bool read(reader& r, std::unordered_set<T, H, Eq, A>& value) { return detail::read_set(r, value); }
+    };
+    template <typename T, typename H, typename Eq, typename A>
+    struct traits<std::unordered_multiset<T, H, Eq, A>>
+    {
+        static inline void write(writer& w, const std::unordered_multiset<T, H, Eq, A>& value) { detail::write_array(w, value); }
+        static inline bool read(reader& r, std::unordered_multiset<T, H, Eq, A>& value) { return detail::read_set(r, value); }
+    };
+    template <typename K, typename V, typename Cmp, typename A>
+    struct traits<std::map<K, V, Cmp, A>>
+    {
+        static inline void write(writer& w, const std::map<K, V, Cmp, A>& value) { detail::write_object(w, value); }
+        static inline bool read(reader& r, std::map<K, V, Cmp, A>& value) { return detail::read_object(r, value); }
+    };
+    template <typename K, typename V, typename Cmp, typename A>
+    struct traits<std::multimap<K, V, Cmp, A>>
+    {
+        static inline void write(writer& w, const std::multimap<K, V, Cmp, A>& value) { detail::write_object(w, value); }
+        static inline bool read(reader& r, std::multimap<K, V, Cmp, A>& value) { return detail::read_object(r, value); }
+    };
+    template <typename K, typename V, typename H, typename Eq, typename A>
+    struct traits<std::unordered_map<K, V, H, Eq, A>>
+    {
+        static inline void write(writer& w, const std::unordered_map<K, V, H, Eq, A>& value) { detail::write_object(w, value); }
+        static inline bool read(reader& r, std::unordered_map<K, V, H, Eq, A>& value) { return detail::read_object(r, value); }
+    };
+    template <typename K, typename V, typename H, typename Eq, typename A>
+    struct traits<std::unordered_multimap<K, V, H, Eq, A>>
+    {
+        static inline void write(writer& w, const std::unordered_multimap<K, V, H, Eq, A>& value) { detail::write_object(w, value); }
+        static inline bool read(reader& r, std::unordered_multimap<K, V, H, Eq, A>& value) { return detail::read_object(r, value); }
+    };
+
+    template <typename T1, typename T2>
+    struct traits<std::pair<T1, T2>>
+    {
+        static inline void write(writer& w, const std::pair<T1, T2>& value) {
+            w.put('[');
+            json::write(w, value.first);
+            w.put(',');
+            json::write(w, value.second);
+            w.put(']');
+        }
+        static inline bool read(reader& r, std::pair<T1, T2>& value) {
+            return r.consume('[') && json::read(r, value.first) && r.consume(',') && json::read(r, value.second) && r.consume(']');
+        }
+    };
+
+    template <typename... T>
+    struct traits<std::tuple<T...>>
+    {
+        static inline void write(writer& w, const std::tuple<T...>& value) { detail::write_tuple(w, value, std::index_sequence_for<T...>()); }
+        static inline bool read(reader& r, std::tuple<T...>& value) { return detail::read_tuple(r, value, std::index_sequence_for<T...>()); }
+    };
+} //namespace json
+} //namespace gbp
+)";
+
+constexpr static const char* runtimeHash =
+R"(#pragma once
+#include "gbp_int.hpp"
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Hashing of GBP types.
+// Generated std::hash specialisations combine gbp::hash_value() of every member in declaration order.
+// Enums hash through their underlying type, contiguous integer containers as one block of bytes,
+// unordered containers independently of their iteration order.
+namespace gbp {
+    // FNV-1a with a seeded basis and a final mix, the generator computes the same function
+    // to build collision-free slot tables for member names and enumerators
+    constexpr gbp_u32 key_hash(std::string_view key, gbp_u32 seed) {
+        gbp_u32 h = 2166136261u ^ seed;
+        for (char c: key) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+        h ^= h >> 13;
+        h *= 0x5bd1e995u;
+        h ^= h >> 15;
+        return h;
+    }
+
+    constexpr std::size_t hash_seed = static_cast<std::size_t>(0x9e3779b97f4a7c15ull);
+
+    /** murmur3 finalizer, every input bit affects every output bit */
+    constexpr gbp_u64 hash_mix(gbp_u64 h) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    /** order dependent */
+    constexpr std::size_t hash_combine(std::size_t seed, std::size_t h) {
+        return static_cast<std::size_t>(hash_mix(static_cast<gbp_u64>(seed) * 31u + h + 0x9e3779b97f4a7c15ull));
+    }
+
+    /** 8 bytes per step, the tail is read as one partial word */
+    inline std::size_t hash_bytes(const void* data, std::size_t size) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        gbp_u64 h = hash_mix(size ^ 0x9e3779b97f4a7c15ull);
+        for (; size >= 8; p += 8, size -= 8) {
+            gbp_u64 word;
+            std::memcpy(&word, p, 8);
+            h = hash_mix(h ^ word) * 0x9e3779b97f4a7c15ull;
+        }
+        if (size > 0) {
+            gbp_u64 word = 0;
+            std::memcpy(&word, p, size);
+            h = hash_mix(h ^ word) * 0x9e3779b97f4a7c15ull;
+        }
+        return static_cast<std::size_t>(hash_mix(h));
+    }
+
+    template <typename T, typename Enable = void>
+    struct hash_traits
+    {
+        static inline std::size_t hash(const T& value) { return std::hash<T>()(value); }
+    };
+
+    template <typename T> inline std::size_t hash_value(const T& value) { return hash_traits<T>::hash(value); }
+
+namespace detail {
+    template <typename T, typename = void> struct is_hash_range : std::false_type {};
+    template <typename T> struct is_hash_range<T, std::void_t<decltype(std::begin(std::declval<const T&>())), decltype(std::end(std::declval<const T&>()))>> : std::true_type {};
+
+    template <typename T, typename = void> struct is_unordered : std::false_type {};
+    template <typename T> struct is_unordered<T, std::void_t<typename T::hasher>> : std::true_type {};
+
+    template <typename T, typename = void> struct is_contiguous : std::false_type {};
+    template <typename T> struct is_contiguous<T, std::void_t<decltype(std::declval<const T&>().data()), decltype(std::declval<const T&>().size())>> : std::true_type {};
+
+    // equal values have equal bytes: no padding, no floating point
+    template <typename T> struct has_unique_bytes : std::integral_constant<bool, std::is_integral<T>::value || std::is_enum<T>::value> {};
+
+    template <typename T, std::size_t... N>
+    inline std::size_t hash_tuple(const T& value, std::index_sequence<N...>) {
+        std::size_t h = hash_seed;
+        ((h = hash_combine(h, hash_value(std::get<N>(value)))), ...);
+        return h;
+    }
+} //namespace detail
+
+    template <typename T>
+    struct hash_traits<T, typename std::enable_if<std::is_enum<T>::value>::type>
+    {
+        static inline std::size_t hash(T value) { return hash_value(static_cast<typename std::underlying_type<T>::type>(value)); }
+    };
+
+    template <typename T>
+    struct hash_traits<T, typename std::enable_if<std::is_integral<T>::value>::type>
+    {
+        static inline std::size_t hash(T value) { return static_cast<std::size_t>(hash_mix(static_cast<gbp_u64>(value))); }
+    };
+
+    template <typename T1, typename T2>
+    struct hash_traits<std::pair<T1, T2>>
+    {
+        static inline std::size_t hash(const std::pair<T1, T2>& value) { return hash_combine(hash_combine(hash_seed, hash_value(value.first)), hash_value(value.second)); }
+    };
+    template <typename... T>
+    struct hash_traits<std::tuple<T...>>
+    {
+        static inline std::size_t hash(const std::tuple<T...>& value) { return detail::hash_tuple(value, std::index_sequence_for<T...>()); }
+    };
+
+    // containers and strings: one block of bytes when possible, a sum of element hashes when unordered, a chain otherwise
+    template <typename T>
+    struct hash_traits<T, typename std::enable_if<detail::is_hash_range<T>::value && !std::is_arithmetic<T>::value>::type>
+    {
+        using value_type = typename std::decay<decltype(*std::begin(std::declval<const T&>()))>::type;
+
+        static inline std::size_t hash(const T& value) {
+            if constexpr (detail::is_contiguous<T>::value && detail::has_unique_bytes<value_type>::value) {
+                return hash_bytes(value.data(), value.size() * sizeof(value_type));
+            } else if constexpr (detail::is_unordered<T>::value) {
+                std::size_t sum = 0;
+                std::size_t count = 0;
+                for (const auto& item: value) {
+                    sum += hash_mix(hash_value(item));
+                    count++;
+                }
+                return hash_combine(hash_combine(hash_seed, count), sum);
+            } else {
+                std::size_t h = hash_seed;
+                std::size_t count = 0;
+                for (const auto& item: value) {
+                    h = hash_combine(h, hash_value(item));
+                    count++;
+                }
+                return hash_combine(h, count);
+            }
+        }
+    };
+} //namespace gbp
+)";
+
+constexpr static const char* runtimeEnum =
+R"(#pragma once
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+// Compile time enumerator tables of GBP enums.
+// The generator defines, next to every enum E and found by ADL:
+//   constexpr gbp::enum_table<E, N> gbp_enum_table(E);  values and names in declaration order
+//   constexpr std::size_t enum_index(E e);             dense index of e, N for values outside the table
+namespace gbp {
+    template <typename E, std::size_t N>
+    struct enum_table
+    {
+        static constexpr std::size_t size = N;
+        std::array<E, N> values;
+        std::array<const char*, N> names;
+        std::array<const char*, N> full_names;
+    };
+
+namespace detail {
+    template <typename E>
+    struct enum_meta
+    {
+        static constexpr auto table = gbp_enum_table(E());
+    };
+} //namespace detail
+
+    template <typename E> constexpr std::size_t enum_count = detail::enum_meta<E>::table.size;
+
+    /** enumerators in declaration order */
+    template <typename E>
+    constexpr const std::array<E, enum_count<E>>& enum_values() { return detail::enum_meta<E>::table.values; }
+
+    template <typename E>
+    constexpr const std::array<const char*, enum_count<E>>& enum_names(bool is_full_name = false) {
+        return is_full_name ? detail::enum_meta<E>::table.full_names : detail::enum_meta<E>::table.names;
+    }
+
+    /** "" for values outside the table */
+    template <typename E>
+    constexpr const char* enum_name(E e, bool is_full_name = false) {
+        std::size_t i = enum_index(e);
+        return i < enum_count<E> ? enum_names<E>(is_full_name)[i] : "";
+    }
+} //namespace gbp
+)";
+
+constexpr static const char* runtimePatch =
+R"(#pragma once
+#include "gbp_codec.hpp"
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Field level patches of GBP types, built on the binary codec:
+// a bitmask of the changed members (varint words, member 0 is the lowest bit), then the new values of those members.
+// Members that are GBP types themselves are written as nested patches, everything else as a whole value.
+namespace gbp {
+    template <std::size_t N>
+    class patch_mask
+    {
+        std::array<gbp_u64, (N + 63) / 64> m_words;
+    public:
+        patch_mask() : m_words() {}
+
+        inline void set(std::size_t i, bool changed) {
+            if (changed) {
+                m_words[i / 64] |= gbp_u64(1) << (i % 64);
+            }
+        }
+        inline bool test(std::size_t i) const { return (m_words[i / 64] >> (i % 64)) & 1u; }
+        inline bool any() const {
+            for (gbp_u64 word: m_words) {
+                if (word != 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        inline void write(buffer& buf) const {
+            for (gbp_u64 word: m_words) {
+                codec::write_varint(buf, word);
+            }
+        }
+        /** fails on bits past the last member */
+        inline bool read(reader& in) {
+            for (gbp_u64& word: m_words) {
+                if (!codec::read_varint(in, word)) {
+                    return false;
+                }
+            }
+            return N % 64 == 0 || (m_words.back() >> (N % 64)) == 0;
+        }
+    };
+
+namespace codec {
+namespace detail {
+    template <typename T, typename = void> struct has_patch : std::false_type {};
+    template <typename T> struct has_patch<T, std::void_t<decltype(T::diff(std::declval<const T&>(), std::declval<const T&>(), std::declval<buffer&>()))>> : std::true_type {};
+} //namespace detail
+
+    template <typename Wire, typename T> inline void write_whole(buffer& buf, const T& value);
+
+namespace detail {
+    template <typename T, std::size_t... N>
+    inline void write_whole_members(buffer& buf, const T& value, std::index_sequence<N...>) {
+        patch_mask<sizeof...(N)> mask;
+        (mask.set(N, true), ...);
+        mask.write(buf);
+        (write_whole<member_wire_t<T, N>>(buf, value.template get_member<N>()), ...);
+        (void)value;
+    }
+} //namespace detail
+
+    /** a patch replacing every member, readable by apply_patch */
+    template <typename Wire, typename T>
+    inline void write_whole(buffer& buf, const T& value) {
+        if constexpr (detail::has_patch<T>::value) {
+            detail::write_whole_members(buf, value, std::make_index_sequence<T::member_count>());
+        } else {
+            write_as<Wire>(buf, value);
+        }
+    }
+
+    template <typename Wire, typename T>
+    inline void write_patch(buffer& buf, const T& from, const T& to) {
+        if constexpr (detail::has_patch<T>::value) {
+            T::diff(from, to, buf);
+        } else {
+            write_as<Wire>(buf, to);
+        }
+    }
+
+    template <typename Wire, typename T>
+    inline bool read_patch(reader& in, T& value) {
+        if constexpr (detail::has_patch<T>::value) {
+            return value.apply_patch(in);
+        } else {
+            return read_as<Wire>(in, value);
+        }
+    }
+} //namespace codec
+} //namespace gbp
+)";
+
+constexpr static const char* runtimeLayout =
+R"(#pragma once
+#include <cstddef>
+#include <tuple>
+
+// Compile time layout of a list of members, used by the types generated with the "layout" tag
+// to report the padding of the declared and the emitted member order.
+namespace gbp {
+    struct layout_info
+    {
+        std::size_t size;
+        std::size_t align;
+        std::size_t padding;
+    };
+
+    /** members of the given types laid out in order, as a struct would */
+    template <typename... T>
+    constexpr layout_info layout_of() {
+        std::size_t offset = 0;
+        std::size_t align = 1;
+        std::size_t data = 0;
+        ((offset = (offset + alignof(T) - 1) / alignof(T) * alignof(T) + sizeof(T),
+          align = alignof(T) > align ? alignof(T) : align,
+          data += sizeof(T)), ...);
+        std::size_t size = offset == 0 ? 1 : (offset + align - 1) / align * align;
+        return layout_info{size, align, size - data};
+    }
+
+    /** the elements N... of a tuple type, in that order */
+    template <typename Tuple, std::size_t... N>
+    using select_t = std::tuple<typename std::tuple_element<N, Tuple>::type...>;
+
+namespace detail {
+    template <typename Tuple, typename... Extra> struct tuple_layout;
+    template <typename... T, typename... Extra>
+    struct tuple_layout<std::tuple<T...>, Extra...>
+    {
+        static constexpr layout_info value = layout_of<T..., Extra...>();
+    };
+} //namespace detail
+
+    /** the tuple elements followed by Extra... */
+    template <typename Tuple, typename... Extra>
+    constexpr layout_info layout_of_tuple() { return detail::tuple_layout<Tuple, Extra...>::value; }
+} //namespace gbp
+)";
+
+constexpr static const char* runtimePch =
+R"(// Precompiled header of the generated API library (CONFIG += gbp_pch in api-gen.pro):
+// the runtime and the standard headers every generated source includes.
+#if defined(__cplusplus)
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <map>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "declare_type.h"
+#endif
+)";
+
+constexpr static const char* runtimeColumns =
+R"(#pragma once
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Structure of arrays storage for the types generated with the "columns" tag:
+// one std::vector per member, so a scan over a few members only touches their columns.
+namespace gbp {
+    template <typename T, typename Tuple = typename T::types_as_tuple> class columns;
+
+    template <typename T, typename... M>
+    class columns<T, std::tuple<M...>>
+    {
+        using index_sequence = std::index_sequence_for<M...>;
+
+        std::tuple<std::vector<M>...> m_columns;
+
+        template <typename U, std::size_t... N>
+        inline void push_members(U& obj, std::index_sequence<N...>) {
+            (std::get<N>(m_columns).push_back(std::move(obj.template get_member<N>())), ...);
+        }
+        template <std::size_t... N>
+        inline void assign_members(T& obj, std::size_t row, std::index_sequence<N...>) const {
+            ((obj.template get_member<N>() = std::get<N>(m_columns)[row]), ...);
+        }
+        template <typename F, std::size_t... N>
+        inline void visit(F& f, std::index_sequence<N...>) {
+            (f(T::member_names[N], std::get<N>(m_columns)), ...);
+        }
+        template <typename F, std::size_t... N>
+        inline void visit(F& f, std::index_sequence<N...>) const {
+            (f(T::member_names[N], std::get<N>(m_columns)), ...);
+        }
+    public:
+        using value_type = T;
+        template <std::size_t N> using column_type = std::vector<typename std::tuple_element<N, std::tuple<M...>>::type>;
+        constexpr static std::size_t column_count = sizeof...(M);
+
+        template <std::size_t N> inline column_type<N>& column() { return std::get<N>(m_columns); }
+        template <std::size_t N> inline const column_type<N>& column() const { return std::get<N>(m_columns); }
+
+        inline std::size_t size() const { return std::get<0>(m_columns).size(); }
+        inline bool empty() const { return std::get<0>(m_columns).empty(); }
+        inline void reserve(std::size_t n) { std::apply([n](auto&... c) { (c.reserve(n), ...); }, m_columns); }
+        inline void clear() { std::apply([](auto&... c) { (c.clear(), ...); }, m_columns); }
+        inline void pop_back() { std::apply([](auto&... c) { (c.pop_back(), ...); }, m_columns); }
+
+        inline void push_back(const T& obj) {
+            T copy(obj);
+            push_members(copy, index_sequence());
+        }
+        inline void push_back(T&& obj) { push_members(obj, index_sequence()); }
+
+        /** the row gathered back into an object */
+        inline T get(std::size_t row) const {
+            T obj;
+            assign_members(obj, row, index_sequence());
+            return obj;
+        }
+
+        /** f(name, column) for every member column, in member order */
+        template <typename F> inline void apply_columns(F&& f)       { visit(f, index_sequence()); }
+        template <typename F> inline void apply_columns(F&& f) const { visit(f, index_sequence()); }
+    };
+} //namespace gbp
+)";
+
+constexpr static const char* runtimeAlloc =
+R"(#pragma once
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+// Uses-allocator construction (std::make_obj_using_allocator of C++20) for the allocator-aware types
+// generated with the "pmr" tag and for the temporaries the decoders move into containers.
+namespace gbp {
+    template <typename T, typename Alloc, typename... Args>
+    inline T make_using_allocator(const Alloc& alloc, Args&&... args) {
+        if constexpr (!std::uses_allocator<T, Alloc>::value) {
+            return T(std::forward<Args>(args)...);
+        } else if constexpr (std::is_constructible<T, std::allocator_arg_t, const Alloc&, Args...>::value) {
+            return T(std::allocator_arg, alloc, std::forward<Args>(args)...);
+        } else {
+            return T(std::forward<Args>(args)..., alloc);
+        }
+    }
+
+    /** a default constructed element sharing the allocator of the container it is moved into, so the move does not copy */
+    template <typename T, typename C>
+    inline T make_element(const C& c) {
+        return make_using_allocator<T>(c.get_allocator());
+    }
+} //namespace gbp
+)";
+
+constexpr static const char* runtimePool =
+R"(#pragma once
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Reuse of generated objects without allocation in steady state:
+// reset() returns every member to its default value keeping the buffers of strings and vectors,
+// the types generated with the "pool" tag keep their released objects per thread for acquire().
+namespace gbp {
+namespace detail {
+    template <typename T, typename = void> struct has_reset : std::false_type {};
+    template <typename T> struct has_reset<T, std::void_t<decltype(std::declval<T&>().reset())>> : std::true_type {};
+
+    template <typename T, typename = void> struct has_clear : std::false_type {};
+    template <typename T> struct has_clear<T, std::void_t<decltype(std::declval<T&>().clear())>> : std::true_type {};
+} //namespace detail
+
+    /** the value initialized state, containers and strings are cleared and keep their capacity */
+    template <typename T>
+    inline void reset_value(T& value) {
+        if constexpr (detail::has_reset<T>::value) {
+            value.reset();
+        } else if constexpr (detail::has_clear<T>::value) {
+            value.clear();
+        } else {
+            value = T();
+        }
+    }
+
+    template <typename T> class pool;
+
+    template <typename T>
+    struct pool_deleter
+    {
+        inline void operator()(T* obj) const { pool<T>::local().release(obj); }
+    };
+
+    /** an object from T::acquire(), going back to the pool of the thread destroying it */
+    template <typename T>
+    using pooled = std::unique_ptr<T, pool_deleter<T>>;
+
+    /**
+     The released objects of one thread, reset and ready to be acquired again.
+     Beyond capacity() released objects are deleted. Objects must not be released
+     while the thread's pool is destroyed, that is from other thread_local destructors.
+     */
+    template <typename T>
+    class pool
+    {
+        std::vector<T*> m_free;
+        std::size_t m_capacity;
+
+        pool() : m_free(), m_capacity(default_capacity) {
+            m_free.reserve(m_capacity);
+        }
+    public:
+        constexpr static std::size_t default_capacity = 64;
+
+        ~pool() {
+            for (T* obj: m_free) {
+                delete obj;
+            }
+        }
+        pool(const pool&) = delete;
+        pool& operator=(const pool&) = delete;
+
+        static inline pool& local() {
+            thread_local pool instance;
+            return instance;
+        }
+
+        inline pooled<T> acquire() {
+            if (m_free.empty()) {
+                return pooled<T>(new T());
+            }
+            T* obj = m_free.back();
+            m_free.pop_back();
+            return pooled<T>(obj);
+        }
+
+        inline void release(T* obj) {
+            if (obj == nullptr) {
+                return;
+            }
+            if (m_free.size() < m_capacity) {
+                obj->reset();
+                m_free.push_back(obj);
+            } else {
+                delete obj;
+            }
+        }
+
+        inline std::size_t size() const { return m_free.size(); }
+        inline std::size_t capacity() const { return m_capacity; }
+        inline void set_capacity(std::size_t capacity) {
+            m_capacity = capacity;
+            while (m_free.size() > m_capacity) {
+                delete m_free.back();
+                m_free.pop_back();
+            }
+            m_free.reserve(m_capacity);
+        }
+    };
+} //namespace gbp
+)";
+
+constexpr static const char* runtimeFixed =
+R"(#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Inline fixed-capacity storage for the members annotated "inline:N":
+// fixed_string<N> replaces std::string and static_vector<T, N> replaces std::vector<T>.
+// Growing past N throws std::length_error, the decoders reject longer input instead.
+namespace gbp {
+namespace detail {
+    template <std::size_t N>
+    using inline_size_t = typename std::conditional<(N < 256), unsigned char,
+                          typename std::conditional<(N < 65536), unsigned short, std::size_t>::type>::type;
+
+    [[noreturn]] inline void throw_length_error(const char* what) { throw std::length_error(what); }
+} //namespace detail
+
+    template <std::size_t N>
+    class fixed_string
+    {
+        using size_type_ = detail::inline_size_t<N>;
+
+        char m_data[N + 1];
+        size_type_ m_size;
+
+        inline void set_size(std::size_t size) {
+            m_size = static_cast<size_type_>(size);
+            m_data[size] = '\0';
+        }
+    public:
+        using value_type = char;
+        using size_type = std::size_t;
+        using iterator = char*;
+        using const_iterator = const char*;
+        constexpr static std::size_t static_capacity = N;
+
+        fixed_string() : m_data(), m_size(0) {}
+        fixed_string(const char* str) : fixed_string() { assign(str, std::strlen(str)); }
+        fixed_string(const char* str, std::size_t size) : fixed_string() { assign(str, size); }
+        fixed_string(std::string_view str) : fixed_string() { assign(str.data(), str.size()); }
+        fixed_string(const std::string& str) : fixed_string() { assign(str.data(), str.size()); }
+
+        inline fixed_string& assign(const char* str, std::size_t size) {
+            if (size > N) {
+                detail::throw_length_error("gbp::fixed_string::assign");
+            }
+            std::memmove(m_data, str, size);
+            set_size(size);
+            return *this;
+        }
+        inline fixed_string& operator=(const char* str) { return assign(str, std::strlen(str)); }
+        inline fixed_string& operator=(std::string_view str) { return assign(str.data(), str.size()); }
+        inline fixed_string& operator=(const std::string& str) { return assign(str.data(), str.size()); }
+
+        inline fixed_string& append(const char* str, std::size_t size) {
+            if (size > N - m_size) {
+                detail::throw_length_error("gbp::fixed_string::append");
+            }
+            std::memcpy(m_data + m_size, str, size);
+            set_size(m_size + size);
+            return *this;
+        }
+        inline fixed_string& operator+=(std::string_view str) { return append(str.data(), str.size()); }
+        inline fixed_string& operator+=(char c) { push_back(c); return *this; }
+        inline void push_back(char c) { append(&c, 1); }
+        inline void pop_back() { set_size(m_size - 1u); }
+        inline void resize(std::size_t size, char c = '\0') {
+            if (size > N) {
+                detail::throw_length_error("gbp::fixed_string::resize");
+            }
+            if (size > m_size) {
+                std::memset(m_data + m_size, c, size - m_size);
+            }
+            set_size(size);
+        }
+        inline void reserve(std::size_t size) const {
+            if (size > N) {
+                detail::throw_length_error("gbp::fixed_string::reserve");
+            }
+        }
+        inline void clear() { set_size(0); }
+
+        inline const char* data() const { return m_data; }
+        inline char* data() { return m_data; }
+        inline const char* c_str() const { return m_data; }
+        inline std::size_t size() const { return m_size; }
+        inline std::size_t length() const { return m_size; }
+        inline bool empty() const { return m_size == 0; }
+        constexpr static std::size_t capacity() { return N; }
+        constexpr static std::size_t max_size() { return N; }
+
+        inline char* begin() { return m_data; }
+        inline char* end() { return m_data + m_size; }
+        inline const char* begin() const { return m_data; }
+        inline const char* end() const { return m_data + m_size; }
+        inline char& operator[](std::size_t i) { return m_data[i]; }
+        inline char operator[](std::size_t i) const { return m_data[i]; }
+        inline char& front() { return m_data[0]; }
+        inline char front() const { return m_data[0]; }
+        inline char& back() { return m_data[m_size - 1u]; }
+        inline char back() const { return m_data[m_size - 1u]; }
+
+        inline operator std::string_view() const { return std::string_view(m_data, m_size); }
+        inline std::string_view view() const { return std::string_view(m_data, m_size); }
+        inline std::string str() const { return std::string(m_data, m_size); }
+    };
+
+    template <std::size_t N, std::size_t M>
+    inline bool operator==(const fixed_string<N>& a, const fixed_string<M>& b) { return a.view() == b.view(); }
+    template <std::size_t N>
+    inline bool operator==(const fixed_string<N>& a, std::string_view b) { return a.view() == b; }
+    template <std::size_t N>
+    inline bool operator==(std::string_view a, const fixed_string<N>& b) { return a == b.view(); }
+    template <std::size_t N, std::size_t M>
+    inline bool operator!=(const fixed_string<N>& a, const fixed_string<M>& b) { return a.view() != b.view(); }
+    template <std::size_t N>
+    inline bool operator!=(const fixed_string<N>& a, std::string_view b) { return a.view() != b; }
+    template <std::size_t N>
+    inline bool operator!=(std::string_view a, const fixed_string<N>& b) { return a != b.view(); }
+    template <std::size_t N, std::size_t M>
+    inline bool operator<(const fixed_string<N>& a, const fixed_string<M>& b) { return a.view() < b.view(); }
+    template <std::size_t N>
+    inline bool operator<(const fixed_string<N>& a, std::string_view b) { return a.view() < b; }
+    template <std::size_t N>
+    inline bool operator<(std::string_view a, const fixed_string<N>& b) { return a < b.view(); }
+
+    template <std::size_t N>
+    inline std::ostream& operator<<(std::ostream& os, const fixed_string<N>& str) { return os << str.view(); }
+
+    template <typename T, std::size_t N>
+    class static_vector
+    {
+        using size_type_ = detail::inline_size_t<N>;
+
+        alignas(T) unsigned char m_storage[N * sizeof(T) > 0 ? N * sizeof(T) : 1];
+        size_type_ m_size;
+
+        inline T* ptr() { return std::launder(reinterpret_cast<T*>(m_storage)); }
+        inline const T* ptr() const { return std::launder(reinterpret_cast<const T*>(m_storage)); }
+        inline void check(std::size_t size, const char* what) const {
+            if (size > N) {
+                detail::throw_length_error(what);
+            }
+        }
+        template <typename It>
+        inline void append(It first, It last) {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = T*;
+        using const_iterator = const T*;
+        constexpr static std::size_t static_capacity = N;
+
+        static_vector() : m_size(0) {}
+        static_vector(std::initializer_list<T> items) : m_size(0) {
+            check(items.size(), "gbp::static_vector");
+            append(items.begin(), items.end());
+        }
+        explicit static_vector(std::size_t size) : m_size(0) { resize(size); }
+        static_vector(const static_vector& other) : m_size(0) { append(other.begin(), other.end()); }
+        static_vector(static_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) : m_size(0) {
+            append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            other.clear();
+        }
+        ~static_vector() { clear(); }
+
+        static_vector& operator=(const static_vector& other) {
+            if (this != &other) {
+                clear();
+                append(other.begin(), other.end());
+            }
+            return *this;
+        }
+        static_vector& operator=(static_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+            if (this != &other) {
+                clear();
+                append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                other.clear();
+            }
+            return *this;
+        }
+        static_vector& operator=(std::initializer_list<T> items) {
+            check(items.size(), "gbp::static_vector");
+            clear();
+            append(items.begin(), items.end());
+            return *this;
+        }
+
+        template <typename... Args>
+        inline T& emplace_back(Args&&... args) {
+            check(m_size + 1u, "gbp::static_vector::emplace_back");
+            T* item = ::new (static_cast<void*>(ptr() + m_size)) T(std::forward<Args>(args)...);
+            m_size++;
+            return *item;
+        }
+        inline void push_back(const T& item) { emplace_back(item); }
+        inline void push_back(T&& item) { emplace_back(std::move(item)); }
+        inline void pop_back() { ptr()[--m_size].~T(); }
+
+        /** at any position, the following elements are shifted */
+        inline T* insert(const T* pos, T item) {
+            std::size_t index = static_cast<std::size_t>(pos - begin());
+            emplace_back(std::move(item));
+            std::rotate(begin() + index, end() - 1, end());
+            return begin() + index;
+        }
+        inline T* erase(const T* first, const T* last) {
+            T* from = begin() + (first - begin());
+            T* to = begin() + (last - begin());
+            std::size_t count = static_cast<std::size_t>(to - from);
+            std::move(to, end(), from);
+            while (count-- > 0) {
+                pop_back();
+            }
+            return from;
+        }
+        inline T* erase(const T* pos) { return erase(pos, pos + 1); }
+
+        inline void resize(std::size_t size) {
+            check(size, "gbp::static_vector::resize");
+            while (m_size > size) {
+                pop_back();
+            }
+            while (m_size < size) {
+                emplace_back();
+            }
+        }
+        inline void resize(std::size_t size, const T& value) {
+            check(size, "gbp::static_vector::resize");
+            while (m_size > size) {
+                pop_back();
+            }
+            while (m_size < size) {
+                emplace_back(value);
+            }
+        }
+        inline void reserve(std::size_t size) const { check(size, "gbp::static_vector::reserve"); }
+        inline void clear() {
+            while (m_size > 0) {
+                pop_back();
+            }
+        }
+        template <typename It>
+        inline void assign(It first, It last) {
+            clear();
+            append(first, last);
+        }
+        inline void assign(std::size_t size, const T& value) {
+            clear();
+            resize(size, value);
+        }
+
+        inline T* data() { return ptr(); }
+        inline const T* data() const { return ptr(); }
+        inline std::size_t size() const { return m_size; }
+        inline bool empty() const { return m_size == 0; }
+        constexpr static std::size_t capacity() { return N; }
+        constexpr static std::size_t max_size() { return N; }
+
+        inline T* begin() { return ptr(); }
+        inline T* end() { return ptr() + m_size; }
+        inline const T* begin() const { return ptr(); }
+        inline const T* end() const { return ptr() + m_size; }
+        inline T& operator[](std::size_t i) { return ptr()[i]; }
+        inline const T& operator[](std::size_t i) const { return ptr()[i]; }
+        inline T& at(std::size_t i) {
+            if (i >= m_size) {
+                throw std::out_of_range("gbp::static_vector::at");
+            }
+            return ptr()[i];
+        }
+        inline const T& at(std::size_t i) const {
+            if (i >= m_size) {
+                throw std::out_of_range("gbp::static_vector::at");
+            }
+            return ptr()[i];
+        }
+        inline T& front() { return ptr()[0]; }
+        inline const T& front() const { return ptr()[0]; }
+        inline T& back() { return ptr()[m_size - 1u]; }
+        inline const T& back() const { return ptr()[m_size - 1u]; }
+    };
+
+    template <typename T, std::size_t N>
+    inline bool operator==(const static_vector<T, N>& a, const static_vector<T, N>& b) { return std::equal(a.begin(), a.end(), b.begin(), b.end()); }
+    template <typename T, std::size_t N>
+    inline bool operator!=(const static_vector<T, N>& a, const static_vector<T, N>& b) { return !(a == b); }
+    template <typename T, std::size_t N>
+    inline bool operator<(const static_vector<T, N>& a, const static_vector<T, N>& b) { return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()); }
+} //namespace gbp
+
+namespace std {
+    template <std::size_t N>
+    struct hash<gbp::fixed_string<N>>
+    {
+        inline std::size_t operator()(const gbp::fixed_string<N>& str) const { return std::hash<std::string_view>()(str.view()); }
+    };
+} //namespace std
+)";
+
+constexpr static const char* runtimeMeta =
+R"(#pragma once
+#include "gbp_codec.hpp"
+#include "gbp_hash.hpp"
+#include "gbp_json.hpp"
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Table-driven reflection: gbp::meta::descriptor<T>::value describes every declared type
+// by member offsets, sizes, type codes and nested descriptors. The functions of gbp_meta.cpp
+// encode, decode, compare, hash and print any declared type from its table with one
+// non-templated implementation, in the formats of the templated paths.
+// Enum names and member types without a type code go through small per type function tables.
+#if defined(__GNUC__)
+#define GBP_META_BEGIN _Pragma("GCC diagnostic push") _Pragma("GCC diagnostic ignored \"-Winvalid-offsetof\"")
+#define GBP_META_END _Pragma("GCC diagnostic pop")
+#else
+#define GBP_META_BEGIN
+#define GBP_META_END
+#endif
+
+namespace gbp {
+namespace meta {
+    enum class type_code : unsigned char
+    {
+        boolean,
+        int8, uint8, int16, uint16, int32, uint32, int64, uint64,
+        float32, float64,
+        string,     // std::string
+        structure,  // declared type, member_info::type
+        sequence,   // std::vector of the code in member_info::element
+        opaque      // anything else, through member_info::ops
+    };
+
+    enum class wire_code : unsigned char
+    {
+        fixed,
+        varint,
+        zigzag,
+        delta
+    };
+
+    struct type_info;
+
+    /** the functions of one member type the table cannot express */
+    struct opaque_ops
+    {
+        void (*encode)(const void* value, buffer& buf);
+        bool (*decode)(void* value, reader& in);
+        bool (*equal)(const void* a, const void* b);
+        std::size_t (*hash)(const void* value);
+        void (*print)(const void* value, json::writer& w);
+    };
+
+    /** std::vector of a declared type */
+    struct sequence_ops
+    {
+        std::size_t (*size)(const void* seq);
+        const void* (*data)(const void* seq);
+        void* (*resize)(void* seq, std::size_t size);   // returns the new data
+        void (*reserve)(void* seq, std::size_t size);
+    };
+
+    struct member_info
+    {
+        const char* name;
+        std::size_t offset;
+        std::size_t size;
+        type_code code;                 // enums: their underlying integer
+        type_code element;              // sequence: the element code, a scalar, string or structure
+        wire_code wire;
+        const type_info* type;          // structure or sequence of structure: the nested descriptor
+        const sequence_ops* sequence;   // sequence of structure
+        const opaque_ops* ops;          // opaque members, and enums for their JSON names
+    };
+
+    struct type_info
+    {
+        const char* name;
+        std::size_t size;
+        std::size_t align;
+        const member_info* members;
+        std::size_t member_count;
+    };
+
+    /** specialised by the generator for every declared type */
+    template <typename T> struct descriptor;
+
+    void encode(const type_info& type, const void* obj, buffer& buf);
+    bool decode(const type_info& type, void* obj, reader& in);
+    bool equal(const type_info& type, const void* a, const void* b);
+    std::size_t hash(const type_info& type, const void* obj);
+    void to_json(const type_info& type, const void* obj, json::writer& w);
+
+    template <typename T> inline void encode(const T& obj, buffer& buf) { encode(descriptor<T>::value, &obj, buf); }
+    template <typename T> inline bool decode(T& obj, reader& in) { return decode(descriptor<T>::value, &obj, in); }
+    template <typename T> inline bool equal(const T& a, const T& b) { return equal(descriptor<T>::value, &a, &b); }
+    template <typename T> inline std::size_t hash(const T& obj) { return hash(descriptor<T>::value, &obj); }
+    template <typename T> inline void to_json(const T& obj, json::writer& w) { to_json(descriptor<T>::value, &obj, w); }
+
+namespace detail {
+    template <typename T, typename = void> struct has_descriptor : std::false_type {};
+    template <typename T> struct has_descriptor<T, std::void_t<decltype(descriptor<T>::value)>> : std::true_type {};
+
+    template <typename T> struct std_vector { using element = void; };
+    template <typename T> struct std_vector<std::vector<T>> { using element = T; };
+
+    template <typename T>
+    constexpr type_code scalar_code() {
+        if constexpr (std::is_same<T, bool>::value) {
+            return type_code::boolean;
+        } else if constexpr (std::is_integral<T>::value) {
+            constexpr bool s = std::is_signed<T>::value;
+            switch (sizeof(T)) {
+            case 1: return s ? type_code::int8 : type_code::uint8;
+            case 2: return s ? type_code::int16 : type_code::uint16;
+            case 4: return s ? type_code::int32 : type_code::uint32;
+            case 8: return s ? type_code::int64 : type_code::uint64;
+            default: return type_code::opaque;
+            }
+        } else if constexpr (std::is_same<T, float>::value) {
+            return type_code::float32;
+        } else if constexpr (std::is_same<T, double>::value) {
+            return type_code::float64;
+        } else {
+            return type_code::opaque;
+        }
+    }
+
+    template <typename Wire>
+    constexpr wire_code wire_code_of() {
+        if constexpr (std::is_same<Wire, wire::varint>::value) {
+            return wire_code::varint;
+        } else if constexpr (std::is_same<Wire, wire::zigzag>::value) {
+            return wire_code::zigzag;
+        } else if constexpr (std::is_same<Wire, wire::delta>::value) {
+            return wire_code::delta;
+        } else {
+            return wire_code::fixed;
+        }
+    }
+
+    template <typename T, typename Wire>
+    struct opaque_ops_for
+    {
+        static void encode(const void* value, buffer& buf) { codec::write_as<Wire>(buf, *static_cast<const T*>(value)); }
+        static bool decode(void* value, reader& in) { return codec::read_as<Wire>(in, *static_cast<T*>(value)); }
+        static bool equal(const void* a, const void* b) { return *static_cast<const T*>(a) == *static_cast<const T*>(b); }
+        static std::size_t hash(const void* value) { return hash_value(*static_cast<const T*>(value)); }
+        static void print(const void* value, json::writer& w) { json::write(w, *static_cast<const T*>(value)); }
+
+        constexpr static opaque_ops value = {&encode, &decode, &equal, &hash, &print};
+    };
+
+    template <typename T>
+    struct sequence_ops_for
+    {
+        static std::size_t size(const void* seq) { return static_cast<const std::vector<T>*>(seq)->size(); }
+        static const void* data(const void* seq) { return static_cast<const std::vector<T>*>(seq)->data(); }
+        static void* resize(void* seq, std::size_t size) {
+            std::vector<T>* v = static_cast<std::vector<T>*>(seq);
+            v->resize(size);
+            return v->data();
+        }
+        static void reserve(void* seq, std::size_t size) { static_cast<std::vector<T>*>(seq)->reserve(size); }
+
+        constexpr static sequence_ops value = {&size, &data, &resize, &reserve};
+    };
+} //namespace detail
+
+    /** the table entry of member N of T, offset is offsetof(T, member) */
+    template <typename T, std::size_t N>
+    constexpr member_info describe_member(const char* name, std::size_t offset) {
+        using M = typename std::tuple_element<N, typename T::types_as_tuple>::type;
+        using Wire = codec::member_wire_t<T, N>;
+        using E = typename detail::std_vector<M>::element;
+
+        member_info info{name, offset, sizeof(M), type_code::opaque, type_code::opaque, detail::wire_code_of<Wire>(), nullptr, nullptr, nullptr};
+        if constexpr (std::is_enum<M>::value) {
+            if constexpr (!codec::detail::has_adl_codec<M>::value) {
+                info.code = detail::scalar_code<typename std::underlying_type<M>::type>();
+            }
+        } else if constexpr (detail::scalar_code<M>() != type_code::opaque) {
+            info.code = detail::scalar_code<M>();
+        } else if constexpr (std::is_same<M, std::string>::value) {
+            info.code = type_code::string;
+        } else if constexpr (detail::has_descriptor<M>::value) {
+            info.code = type_code::structure;
+            info.type = &descriptor<M>::value;
+        } else if constexpr (std::is_same<E, std::string>::value) {
+            info.code = type_code::sequence;
+            info.element = type_code::string;
+        } else if constexpr (!std::is_void<E>::value && !std::is_enum<E>::value && detail::scalar_code<E>() != type_code::opaque && !std::is_same<E, bool>::value) {
+            info.code = type_code::sequence;
+            info.element = detail::scalar_code<E>();
+        } else if constexpr (!std::is_void<E>::value && detail::has_descriptor<E>::value) {
+            info.code = type_code::sequence;
+            info.element = type_code::structure;
+            info.type = &descriptor<E>::value;
+            info.sequence = &detail::sequence_ops_for<E>::value;
+        }
+        if (info.code == type_code::opaque || std::is_enum<M>::value) {
+            info.ops = &detail::opaque_ops_for<M, Wire>::value;
+        }
+        return info;
+    }
+} //namespace meta
+} //namespace gbp
+)";
+
+constexpr static const char* runtimeMetaSource =
+R"(#include "declare_type.h"
+
+// One implementation for every declared type, driven by gbp::meta::type_info.
+// The scalar cases reuse the codec, JSON and hashing of gbp_codec.hpp, gbp_json.hpp and gbp_hash.hpp,
+// so the output matches encode(), to_json() and std::hash of the generated types.
+namespace gbp {
+namespace meta {
+namespace {
+    template <typename T> struct tag { using type = T; };
+
+    // calls f(tag<T>()) with the C++ type of a numeric code, sequence elements are never bool
+    template <typename F>
+    inline auto visit_number(type_code code, F&& f) {
+        switch (code) {
+        case type_code::int8:    return f(tag<gbp_i8>());
+        case type_code::uint8:   return f(tag<gbp_u8>());
+        case type_code::int16:   return f(tag<gbp_i16>());
+        case type_code::uint16:  return f(tag<gbp_u16>());
+        case type_code::int32:   return f(tag<gbp_i32>());
+        case type_code::uint32:  return f(tag<gbp_u32>());
+        case type_code::int64:   return f(tag<gbp_i64>());
+        case type_code::uint64:  return f(tag<gbp_u64>());
+        case type_code::float32: return f(tag<float>());
+        default:                 return f(tag<double>());
+        }
+    }
+    template <typename F>
+    inline auto visit_scalar(type_code code, F&& f) {
+        return code == type_code::boolean ? f(tag<bool>()) : visit_number(code, f);
+    }
+
+    inline const void* member_ptr(const void* obj, const member_info& m) {
+        return static_cast<const unsigned char*>(obj) + m.offset;
+    }
+    inline void* member_ptr(void* obj, const member_info& m) {
+        return static_cast<unsigned char*>(obj) + m.offset;
+    }
+
+    template <typename T>
+    inline void write_wired(buffer& buf, const T& value, wire_code wire) {
+        if constexpr (codec::detail::is_wire_integer<T> || codec::detail::is_integer_container<T>::value) {
+            switch (wire) {
+            case wire_code::varint: codec::write_as<wire::varint>(buf, value); return;
+            case wire_code::zigzag: codec::write_as<wire::zigzag>(buf, value); return;
+            default: break;
+            }
+        }
+        if constexpr (codec::detail::is_integer_container<T>::value) {
+            if (wire == wire_code::delta) {
+                codec::write_as<wire::delta>(buf, value);
+                return;
+            }
+        }
+        codec::write(buf, value);
+    }
+
+    template <typename T>
+    inline bool read_wired(reader& in, T& value, wire_code wire) {
+        if constexpr (codec::detail::is_wire_integer<T> || codec::detail::is_integer_container<T>::value) {
+            switch (wire) {
+            case wire_code::varint: return codec::read_as<wire::varint>(in, value);
+            case wire_code::zigzag: return codec::read_as<wire::zigzag>(in, value);
+            default: break;
+            }
+        }
+        if constexpr (codec::detail::is_integer_container<T>::value) {
+            if (wire == wire_code::delta) {
+                return codec::read_as<wire::delta>(in, value);
+            }
+        }
+        return codec::read(in, value);
+    }
+
+    void encode_member(const member_info& m, const void* p, buffer& buf)
+    {
+        switch (m.code) {
+        case type_code::string:
+            codec::write(buf, *static_cast<const std::string*>(p));
+            return;
+        case type_code::structure:
+            encode(*m.type, p, buf);
+            return;
+        case type_code::opaque:
+            m.ops->encode(p, buf);
+            return;
+        case type_code::sequence:
+            if (m.element == type_code::string) {
+                codec::write(buf, *static_cast<const std::vector<std::string>*>(p));
+            } else if (m.element == type_code::structure) {
+                std::size_t size = m.sequence->size(p);
+                const unsigned char* data = static_cast<const unsigned char*>(m.sequence->data(p));
+                codec::write_count(buf, size);
+                for (std::size_t i = 0; i < size; i++) {
+                    encode(*m.type, data + i * m.type->size, buf);
+                }
+            } else {
+                visit_number(m.element, [&](auto t) {
+                    write_wired(buf, *static_cast<const std::vector<typename decltype(t)::type>*>(p), m.wire);
+                });
+            }
+            return;
+        default:
+            visit_scalar(m.code, [&](auto t) {
+                write_wired(buf, *static_cast<const typename decltype(t)::type*>(p), m.wire);
+            });
+            return;
+        }
+    }
+
+    bool decode_member(const member_info& m, void* p, reader& in)
+    {
+        switch (m.code) {
+        case type_code::string:
+            return codec::read(in, *static_cast<std::string*>(p));
+        case type_code::structure:
+            return decode(*m.type, p, in);
+        case type_code::opaque:
+            return m.ops->decode(p, in);
+        case type_code::sequence:
+            if (m.element == type_code::string) {
+                return codec::read(in, *static_cast<std::vector<std::string>*>(p));
+            } else if (m.element == type_code::structure) {
+                std::size_t count;
+                if (!codec::read_count(in, count)) {
+                    return false;
+                }
+                // grown as the input is consumed, the count alone may not be trusted
+                m.sequence->reserve(p, count < in.remaining() ? count : in.remaining());
+                std::size_t size = m.sequence->size(p);
+                unsigned char* data = static_cast<unsigned char*>(m.sequence->resize(p, size));
+                for (std::size_t i = 0; i < count; i++) {
+                    if (i == size) {
+                        data = static_cast<unsigned char*>(m.sequence->resize(p, ++size));
+                    }
+                    if (!decode(*m.type, data + i * m.type->size, in)) {
+                        return false;
+                    }
+                }
+                m.sequence->resize(p, count);
+                return true;
+            } else {
+                return visit_number(m.element, [&](auto t) {
+                    return read_wired(in, *static_cast<std::vector<typename decltype(t)::type>*>(p), m.wire);
+                });
+            }
+        default:
+            return visit_scalar(m.code, [&](auto t) {
+                return read_wired(in, *static_cast<typename decltype(t)::type*>(p), m.wire);
+            });
+        }
+    }
+
+    bool equal_member(const member_info& m, const void* a, const void* b)
+    {
+        switch (m.code) {
+        case type_code::string:
+            return *static_cast<const std::string*>(a) == *static_cast<const std::string*>(b);
+        case type_code::structure:
+            return equal(*m.type, a, b);
+        case type_code::opaque:
+            return m.ops->equal(a, b);
+        case type_code::sequence:
+            if (m.element == type_code::string) {
+                return *static_cast<const std::vector<std::string>*>(a) == *static_cast<const std::vector<std::string>*>(b);
+            } else if (m.element == type_code::structure) {
+                std::size_t size = m.sequence->size(a);
+                if (size != m.sequence->size(b)) {
+                    return false;
+                }
+                const unsigned char* da = static_cast<const unsigned char*>(m.sequence->data(a));
+                const unsigned char* db = static_cast<const unsigned char*>(m.sequence->data(b));
+                for (std::size_t i = 0; i < size; i++) {
+                    if (!equal(*m.type, da + i * m.type->size, db + i * m.type->size)) {
+                        return false;
+                    }
+                }
+                return true;
+            } else {
+                return visit_number(m.element, [&](auto t) {
+                    using V = std::vector<typename decltype(t)::type>;
+                    return *static_cast<const V*>(a) == *static_cast<const V*>(b);
+                });
+            }
+        default:
+            return visit_scalar(m.code, [&](auto t) {
+                using T = typename decltype(t)::type;
+                return *static_cast<const T*>(a) == *static_cast<const T*>(b);
+            });
+        }
+    }
+
+    std::size_t hash_member(const member_info& m, const void* p)
+    {
+        switch (m.code) {
+        case type_code::string:
+            return hash_value(*static_cast<const std::string*>(p));
+        case type_code::structure:
+            return hash(*m.type, p);
+        case type_code::opaque:
+            return m.ops->hash(p);
+        case type_code::sequence:
+            if (m.element == type_code::string) {
+                return hash_value(*static_cast<const std::vector<std::string>*>(p));
+            } else if (m.element == type_code::structure) {
+                std::size_t size = m.sequence->size(p);
+                const unsigned char* data = static_cast<const unsigned char*>(m.sequence->data(p));
+                // the order dependent chain of hash_traits for ranges
+                std::size_t h = hash_seed;
+                for (std::size_t i = 0; i < size; i++) {
+                    h = hash_combine(h, hash(*m.type, data + i * m.type->size));
+                }
+                return hash_combine(h, size);
+            } else {
+                return visit_number(m.element, [&](auto t) {
+                    return hash_value(*static_cast<const std::vector<typename decltype(t)::type>*>(p));
+                });
+            }
+        default:
+            return visit_scalar(m.code, [&](auto t) {
+                return hash_value(*static_cast<const typename decltype(t)::type*>(p));
+            });
+        }
+    }
+
+    void print_member(const member_info& m, const void* p, json::writer& w)
+    {
+        if (m.ops != nullptr) {
+            m.ops->print(p, w);
+            return;
+        }
+        switch (m.code) {
+        case type_code::string:
+            json::write(w, *static_cast<const std::string*>(p));
+            return;
+        case type_code::structure:
+            to_json(*m.type, p, w);
+            return;
+        case type_code::sequence:
+            if (m.element == type_code::string) {
+                json::write(w, *static_cast<const std::vector<std::string>*>(p));
+            } else if (m.element == type_code::structure) {
+                std::size_t size = m.sequence->size(p);
+                const unsigned char* data = static_cast<const unsigned char*>(m.sequence->data(p));
+                w.put('[');
+                for (std::size_t i = 0; i < size; i++) {
+                    if (i > 0) {
+                        w.put(',');
+                    }
+                    to_json(*m.type, data + i * m.type->size, w);
+                }
+                w.put(']');
+            } else {
+                visit_number(m.element, [&](auto t) {
+                    json::write(w, *static_cast<const std::vector<typename decltype(t)::type>*>(p));
+                });
+            }
+            return;
+        default:
+            visit_scalar(m.code, [&](auto t) {
+                json::write(w, *static_cast<const typename decltype(t)::type*>(p));
+            });
+            return;
+        }
+    }
+} //namespace
+
+    void encode(const type_info& type, const void* obj, buffer& buf)
+    {
+        for (std::size_t i = 0; i < type.member_count; i++) {
+            const member_info& m = type.members[i];
+            encode_member(m, member_ptr(obj, m), buf);
+        }
+    }
+
+    bool decode(const type_info& type, void* obj, reader& in)
+    {
+        for (std::size_t i = 0; i < type.member_count; i++) {
+            const member_info& m = type.members[i];
+            if (!decode_member(m, member_ptr(obj, m), in)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool equal(const type_info& type, const void* a, const void* b)
+    {
+        for (std::size_t i = 0; i < type.member_count; i++) {
+            const member_info& m = type.members[i];
+            if (!equal_member(m, member_ptr(a, m), member_ptr(b, m))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::size_t hash(const type_info& type, const void* obj)
+    {
+        std::size_t h = hash_seed;
+        for (std::size_t i = 0; i < type.member_count; i++) {
+            const member_info& m = type.members[i];
+            h = hash_combine(h, hash_member(m, member_ptr(obj, m)));
+        }
+        return h;
+    }
+
+    void to_json(const type_info& type, const void* obj, json::writer& w)
+    {
+        w.put('{');
+        for (std::size_t i = 0; i < type.member_count; i++) {
+            const member_info& m = type.members[i];
+            if (i > 0) {
+                w.put(',');
+            }
+            w.string(m.name);
+            w.put(':');
+            print_member(m, member_ptr(obj, m), w);
+        }
+        w.put('}');
+    }
+} //namespace meta
+} //namespace gbp
+)";
+
+constexpr static const char* runtimeRegistryHeader =
+R"(#pragma once
+#include "declare_type.h"
+#include <utility>
+
+// Type ids: every generated type has type_id, gbp::key_hash of its qualified name with seed 0,
+// so the id only changes when the type is renamed or moved.
+// The generator collects the types of all headers into api_registry.hpp, where gbp::registry::find()
+// and gbp::registry::visit() go from an id to its type through one collision-free slot table.
+namespace gbp {
+    /** one entry of the project registry, size and alignment are in info */
+    struct registered_type
+    {
+        gbp_u32 id;
+        gbp_u64 fingerprint; // schema_fingerprint, see gbp::codec::decode_message
+        const meta::type_info* info;
+        void* (*create)();
+        void (*destroy)(void* obj);
+    };
+
+namespace detail {
+    template <typename T> void* create_registered() { return new T(); }
+    template <typename T> void destroy_registered(void* obj) { delete static_cast<T*>(obj); }
+} //namespace detail
+
+    template <typename T>
+    constexpr registered_type make_registered() {
+        return registered_type{T::type_id, T::schema_fingerprint, &meta::descriptor<T>::value, &detail::create_registered<T>, &detail::destroy_registered<T>};
+    }
+
+    /** decodes the whole of data into a T and passes it to handler, false if data is not a valid T */
+    template <typename T, typename Handler>
+    inline bool visit_as(byte_span data, Handler&& handler) {
+        T value;
+        if (!value.decode(data)) {
+            return false;
+        }
+        std::forward<Handler>(handler)(value);
+        return true;
+    }
+} //namespace gbp
+)";
+
+QList<RuntimeFile> runtimeFiles()
+{
+    return QList<RuntimeFile>() << RuntimeFile{"declare_type.h",   runtimeDeclareType}
+                                << RuntimeFile{"gbp_int.hpp",      runtimeInt}
+                                << RuntimeFile{"gbp_codec.hpp",    runtimeCodec}
+                                << RuntimeFile{"gbp_view.hpp",     runtimeView}
+                                << RuntimeFile{"gbp_json.hpp",     runtimeJson}
+                                << RuntimeFile{"gbp_hash.hpp",     runtimeHash}
+                                << RuntimeFile{"gbp_enum.hpp",     runtimeEnum}
+                                << RuntimeFile{"gbp_patch.hpp",    runtimePatch}
+                                << RuntimeFile{"gbp_layout.hpp",   runtimeLayout}
+                                << RuntimeFile{"gbp_pch.h",        runtimePch}
+                                << RuntimeFile{"gbp_columns.hpp",  runtimeColumns}
+                                << RuntimeFile{"gbp_alloc.hpp",    runtimeAlloc}
+                                << RuntimeFile{"gbp_pool.hpp",     runtimePool}
+                                << RuntimeFile{"gbp_fixed.hpp",    runtimeFixed}
+                                << RuntimeFile{"gbp_meta.hpp",     runtimeMeta}
+                                << RuntimeFile{"gbp_meta.cpp",     runtimeMetaSource}
+                                << RuntimeFile{"gbp_registry.hpp", runtimeRegistryHeader};
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <qlist.h>
+#include <qstring.h>
+
+/** support header written to the root of the generated api, generated code depends on it */
+struct RuntimeFile {
+    QString name;           // relative to the api-gen root
+    const char* content;
+};
+
+QList<RuntimeFile> runtimeFiles();
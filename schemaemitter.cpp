@@ -0,0 +1,79 @@
+#include "schemaemitter.hpp"
+#include "codecemitter.hpp"
+
+#include <qregularexpression.h>
+
+QString SchemaEmitter::name() const {
+    return "schema";
+}
+
+void SchemaEmitter::emitStruct(const TypeDescriptor& type, TypeCode& code)
+{
+    // the struct and the structs enclosing it are incomplete here, members referring to them are covered by their spelling
+    QStringList incomplete = type.fullName.split("::");
+    QStringList composed;
+    QString schema = "struct " + type.qualifiedName + " {";
+    for (const MemberDescriptor& member: type.members) {
+        // no wire tag is the fixed width encoding
+        QString wire = CodecEmitter::wireType(member);
+        schema += QString(" %0: %1 %2;").arg(member.name)
+                                        .arg(canonicalType(member.type))
+                                        .arg(wire.isEmpty() ? QString("gbp::wire::fixed") : wire);
+        if (!refersTo(member.type, incomplete)) {
+            composed << member.type;
+        }
+    }
+    schema += " }";
+
+    // member types declared elsewhere, in this header or another one, are folded in by the compiler
+    code.operators += QString("constexpr static const gbp_u64 schema_fingerprint = gbp::codec::fingerprint_mix(0x%0ull, gbp::codec::schema_fingerprint_of<std::tuple<%1>>::value());\n")
+                      .arg(fingerprint(schema.toUtf8()), 16, 16, QChar('0'))
+                      .arg(composed.join(", "));
+}
+
+void SchemaEmitter::emitEnum(const TypeDescriptor& type, TypeCode& code)
+{
+    // simple enums are written as 32 bit
+    QString underlying = type.kind == TypeDescriptor::Kind::EnumClass ? type.underlyingType : QString("gbp_i32");
+    QStringList items;
+    for (const QString& item: type.enumItemsDecl) {
+        items << item.simplified();
+    }
+    quint64 value = fingerprint(QString("enum %0: %1 { %2 }").arg(type.qualifiedName).arg(underlying).arg(items.join(' ')).toUtf8());
+    // only named in decltype by gbp::codec::schema_fingerprint_of, usable while an enclosing struct is incomplete
+    code.related += QString("%9std::integral_constant<gbp_u64, 0x%1ull> gbp_schema_fingerprint(%0);\n")
+                    .arg(type.name)
+                    .arg(value, 16, 16, QChar('0'))
+                    .arg(type.friendPrefix());
+}
+
+quint64 SchemaEmitter::fingerprint(const QByteArray& schema)
+{
+    quint64 h = 14695981039346656037ull;
+    for (char c: schema) {
+        h ^= quint64(uchar(c));
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+QString SchemaEmitter::canonicalType(const QString& type)
+{
+    static const QRegularExpression spaceRe("\\s*([<>,*&])\\s*");
+
+    // polymorphic allocators do not change the encoding
+    return type.simplified().replace(spaceRe, "\\1").replace("std::pmr::", "std::");
+}
+
+bool SchemaEmitter::refersTo(const QString& type, const QStringList& names)
+{
+    static const QRegularExpression identifierRe("[A-Za-z_][A-Za-z_0-9:]*");
+
+    QRegularExpressionMatchIterator it = identifierRe.globalMatch(type);
+    while (it.hasNext()) {
+        if (names.contains(it.next().captured(0).split("::").last())) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "emitter.hpp"
+
+/**
+ Schema fingerprints (gbp::codec::encode_message/decode_message in gbp_codec.hpp).
+ Every struct gets schema_fingerprint, a 64 bit FNV-1a over its qualified name, the names, types and wires
+ of its members, folded at compile time with the fingerprints of its member types, so that enums and structs
+ declared in other headers contribute as well. Every enum declares its fingerprint by gbp_schema_fingerprint().
+ Peers built from the same declarations agree on it, any change of the encoding changes it.
+ */
+class SchemaEmitter : public Emitter
+{
+public:
+    virtual QString name() const override;
+
+    virtual void emitStruct(const TypeDescriptor& type, TypeCode& code) override;
+    virtual void emitEnum(const TypeDescriptor& type, TypeCode& code) override;
+
+    static quint64 fingerprint(const QByteArray& schema);
+private:
+    /** the member type with its spelling normalised */
+    static QString canonicalType(const QString& type);
+    /** true if an identifier in type ends with one of the names */
+    static bool refersTo(const QString& type, const QStringList& names);
+};
@@ -0,0 +1,156 @@
+#include "sourceformatter.hpp"
+#include "outputwriter.hpp"
+
+#include <qatomic.h>
+#include <qdebug.h>
+#include <qprocess.h>
+#include <qrunnable.h>
+#include <qsemaphore.h>
+#include <qstandardpaths.h>
+#include <qthread.h>
+#include <qthreadpool.h>
+
+#include <functional>
+
+namespace
+{
+    class FormatJob : public QRunnable
+    {
+        std::function<void()> m_func;
+    public:
+        explicit FormatJob(std::function<void()> func)
+            : QRunnable()
+            , m_func(func)
+        {
+            setAutoDelete(true);
+        }
+        virtual void run() override {
+            m_func();
+        }
+    };
+} //namespace
+
+struct SourceFormatter::Impl
+{
+    OutputWriter* m_writer;
+    QString m_program;
+    QString m_style;
+    QThreadPool m_pool;
+    QSemaphore m_slots;
+    QAtomicInt m_formatted;
+    QAtomicInt m_failed;
+
+    Impl(OutputWriter* writer, int jobCount)
+        : m_writer(writer)
+        , m_program(SourceFormatter::defaultProgram())
+        , m_style(SourceFormatter::defaultStyle())
+        , m_pool()
+        , m_slots(jobCount * 3)
+        , m_formatted(0)
+        , m_failed(0)
+    {
+        m_pool.setMaxThreadCount(jobCount);
+    }
+
+    /** content as is when formatting fails */
+    QByteArray runFormatter(const QString& path, const QByteArray& content, bool& formatted)
+    {
+        formatted = false;
+        QProcess process;
+        process.start(m_program, QStringList() << "-style=" + m_style << "-assume-filename=" + path);
+        if (process.waitForStarted())
+        {
+            process.write(content);
+            process.closeWriteChannel();
+            if (process.waitForFinished(-1) && process.exitStatus() == QProcess::NormalExit && process.exitCode() == 0) {
+                m_formatted.ref();
+                formatted = true;
+                return process.readAllStandardOutput();
+            }
+        }
+        m_failed.ref();
+        qWarning() << "cannot format" << path << process.readAllStandardError();
+        return content;
+    }
+};
+
+SourceFormatter::SourceFormatter(OutputWriter* writer, int jobCount)
+    : m_impl(new Impl(writer, jobCount > 0 ? jobCount : qMax(1, QThread::idealThreadCount())))
+{}
+
+SourceFormatter::~SourceFormatter()
+{
+    wait();
+    delete m_impl;
+}
+
+QString SourceFormatter::defaultProgram()
+{
+    QString program = qEnvironmentVariable("GBP_CLANG_FORMAT");
+    if (program.isEmpty()) {
+        program = QStandardPaths::findExecutable("clang-format");
+    }
+    return program;
+}
+
+QString SourceFormatter::defaultStyle()
+{
+    QString style = qEnvironmentVariable("GBP_CLANG_FORMAT_STYLE");
+    return style.isEmpty() ? QString("WebKit") : style;
+}
+
+void SourceFormatter::setProgram(const QString& program) {
+    m_impl->m_program = program;
+}
+
+QString SourceFormatter::program() const {
+    return m_impl->m_program;
+}
+
+void SourceFormatter::setStyle(const QString& style) {
+    m_impl->m_style = style;
+}
+
+QString SourceFormatter::style() const {
+    return m_impl->m_style;
+}
+
+bool SourceFormatter::isAvailable() const {
+    return !m_impl->m_program.isEmpty();
+}
+
+void SourceFormatter::format(const QString& path, const QByteArray& content, const Completion& done)
+{
+    auto written = [done](bool formatted) {
+        return OutputWriter::Completion([done, formatted](bool ok) {
+            if (done) {
+                done(ok, formatted);
+            }
+        });
+    };
+    if (!isAvailable()) {
+        m_impl->m_writer->write(path, content, written(false));
+        return;
+    }
+
+    // back-pressure: running jobs plus the ones waiting for a thread
+    m_impl->m_slots.acquire();
+    m_impl->m_pool.start(new FormatJob([this, path, content, written]{
+        bool formatted;
+        QByteArray result = m_impl->runFormatter(path, content, formatted);
+        m_impl->m_writer->write(path, result, written(formatted));
+        m_impl->m_slots.release();
+    }));
+}
+
+void SourceFormatter::wait() {
+    m_impl->m_pool.waitForDone();
+}
+
+int SourceFormatter::formattedCount() const {
+    return m_impl->m_formatted.load();
+}
+
+int SourceFormatter::failedCount() const {
+    return m_impl->m_failed.load();
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <qbytearray.h>
+#include <qstring.h>
+
+#include "outputwriter.hpp"
+
+/**
+ Runs clang-format on generated sources in parallel and hands the result to an OutputWriter.
+ At most jobCount processes run at once and at most twice as many buffers wait for a free slot,
+ format() blocks beyond that.
+ The binary is taken from $GBP_CLANG_FORMAT or looked up in PATH; the style from $GBP_CLANG_FORMAT_STYLE.
+ Without a binary, or when it fails, the sources are written as generated.
+ */
+class SourceFormatter
+{
+public:
+    /** called on a writer thread, formatted is false when the source was written as generated */
+    using Completion = std::function<void(bool written, bool formatted)>;
+private:
+    struct Impl;
+    Impl* m_impl;
+public:
+    explicit SourceFormatter(OutputWriter* writer, int jobCount = 0);
+    ~SourceFormatter();
+
+    SourceFormatter(const SourceFormatter&) = delete;
+    SourceFormatter& operator=(const SourceFormatter&) = delete;
+
+    static QString defaultProgram();
+    static QString defaultStyle();
+
+    void setProgram(const QString& program);
+    QString program() const;
+    void setStyle(const QString& style);
+    QString style() const;
+    bool isAvailable() const;
+
+    void format(const QString& path, const QByteArray& content, const Completion& done = Completion());
+    /** blocks until every queued source is formatted and handed to the writer */
+    void wait();
+
+    int formattedCount() const;
+    int failedCount() const;
+};
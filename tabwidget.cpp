@@ -3,6 +3,7 @@
 #include "page.h"
 
 #include <qtoolbar.h>
+#include <qfile.h>
 #include <qfileinfo.h>
 #include <qfiledialog.h>
 #include <QSaveFile>
@@ -11,6 +12,11 @@
 #include <qdebug.h>
 
 #include "checkedfileslist.hpp"
+#include "outputmanifest.hpp"
+#include "outputwriter.hpp"
+#include "registryemitter.hpp"
+#include "runtime.hpp"
+#include "sourceformatter.hpp"
 
 const char* path = "G:\\_msys64_\\home\\Deadreact\\ultima_poker-client\\common\\api\\gbp_int.hpp";
 
@@ -34,6 +40,20 @@ struct TabWidget::Impl : Ui_TabWidget
         actionOpenDir->setIcon(w->style()->standardIcon(QStyle::SP_DirOpenIcon));
     }
 
+    bool writeIfChanged(OutputManifest& manifest, OutputWriter& writer, const QString& path, const QString& content)
+    {
+        QByteArray data = content.toUtf8();
+        if (manifest.update(path, data)) {
+            writer.write(path, data, [&manifest, path](bool ok) {
+                if (ok) {
+                    manifest.commit(path);
+                }
+            });
+            return true;
+        }
+        return false;
+    }
+
     QStringList getFilesRecursively(const QString& dir) {
         QStringList lst;
 
@@ -141,38 +161,65 @@ void TabWidget::on_actionGenerate_triggered()
     QList<Page*> pages = findChildren<Page*>();
     QStringList headers;
     QStringList sources;
-    QStringList consoleCommands;
+    QMap<QString, QStringList> unitySources; // directory relative to api-gen -> its sources
+    QSet<QString> generatedSources; // headers of the pages written in this run
+    QStringList registryIncludes;
+    QStringList registryTypes;
     static const QRegularExpression re("/api-gen(/.+)");
     QString rootPath;
+    for (Page* page: pages) {
+        if (!page->declCode().isEmpty()) {
+            QString path = QFileInfo(page->filepath()).absolutePath().replace("/api", "/api-gen");
+            rootPath = QRegularExpression(".+/api-gen").match(path).captured(0);
+            break;
+        }
+    }
+    if (rootPath.isEmpty()) {
+        return;
+    }
+
+    OutputManifest manifest(rootPath);
+    manifest.load();
+    OutputWriter writer;
+    SourceFormatter formatter(&writer);
+    if (!formatter.isAvailable()) {
+        qWarning() << "clang-format not found, set GBP_CLANG_FORMAT; generated sources are written unformatted";
+    }
+
+    // unchanged sources are neither formatted nor rewritten, so they keep their mtime;
+    // the ones written unformatted are formatted as soon as clang-format is there
+    auto writeFormatted = [&](const QString& path, const QString& content) {
+        QByteArray data = content.toUtf8();
+        if (manifest.update(path, data, formatter.isAvailable())) {
+            formatter.format(path, data, [&manifest, path](bool written, bool formatted) {
+                if (written) {
+                    manifest.commit(path, formatted);
+                }
+            });
+        }
+    };
+
     for (Page* page: pages) {
         if (!page->declCode().isEmpty())
         {
             QFileInfo info(page->filepath());
             QString path = info.absolutePath().replace("/api", "/api-gen");
-            if (rootPath.isEmpty()) {
-                rootPath = QRegularExpression(".+/api-gen").match(path).captured(0);
-            }
-            QDir().mkpath(path);
             QString capt = re.match(path).captured(1);
+            generatedSources.insert(info.absoluteFilePath());
 
             QString filename = info.baseName();
 
+            // extern template declarations go after the header, their instantiations into its source
+            Code externs = page->exportedCode("extern");
+
             QString newFilePath = path + "/" + filename + "." + info.suffix();
-            QSaveFile header(newFilePath + ".tmp");
-            if (header.open(QIODevice::WriteOnly)) {
-                headers << ("$$PWD" + capt + "/" + info.baseName() + "." + info.suffix());
-                QTextStream stream(&header);
-                stream.setCodec(QTextCodec::codecForName("UTF-8"));
-//                stream << ("#include \"gbp_int.hpp\"\n");
-//                if (filename.contains("reply") || filename.contains("request")) {
-//                    QString extraInclude = "#pragma once\n#include \"declare_type.h\"\n#include <api" + capt + "/" + info.baseName() + "." + info.suffix() + ">";
-//                    stream << page->declCode().replace("#pragma once", extraInclude);
-//                } else {
-//                }
-                stream << page->declCode();
-                header.commit();
+            headers << ("$$PWD" + capt + "/" + info.baseName() + "." + info.suffix());
+            QString registered = page->exportedCode("registry").decl;
+            if (!registered.isEmpty()) {
+                registryIncludes << (capt.isEmpty() ? QString() : capt.mid(1) + "/") + info.baseName() + "." + info.suffix();
+                registryTypes << registered.split('\n');
             }
-            consoleCommands << QString("G:\\_msys64_\\mingw32\\bin\\clang-format.exe -style=WebKit %0.tmp > %0 && rm %0.tmp").arg(newFilePath).toLatin1();
+            writeFormatted(newFilePath, externs.decl.isEmpty() ? page->declCode() : page->declCode() + "\n" + externs.decl);
             if (!page->implCode().isEmpty())
             {
                 if (filenames.contains(filename))
@@ -186,203 +233,106 @@ void TabWidget::on_actionGenerate_triggered()
                 filenames.insert(filename);
 
                 newFilePath = path + "/" + filename + ".cpp";
-                QSaveFile cpp(newFilePath + ".tmp");
-                if (cpp.open(QIODevice::WriteOnly)) {
-                    sources << ("$$PWD" + capt + "/" + filename + ".cpp");
-                    QTextStream stream(&cpp);
-                    stream.setCodec(QTextCodec::codecForName("UTF-8"));
-                    stream << ("#include \"" + info.baseName() + "." + info.suffix() + "\"\n");
-                    stream << page->implCode();
-                    cpp.commit();
-                }
-                consoleCommands << QString("G:\\_msys64_\\mingw32\\bin\\clang-format.exe -style=WebKit %0.tmp > %0 && rm %0.tmp").arg(newFilePath).toLatin1();
+                sources << ("$$PWD" + capt + "/" + filename + ".cpp");
+                unitySources[capt] << (filename + ".cpp");
+                writeFormatted(newFilePath, "#include \"" + info.baseName() + "." + info.suffix() + "\"\n" + page->implCode() + (externs.impl.isEmpty() ? QString() : "\n" + externs.impl));
             }
         }
     }
 
-    QSaveFile priFile(rootPath + "/api-gen.pri");
-    if (priFile.open(QIODevice::WriteOnly)) {
-        QTextStream stream(&priFile);
-        stream.setCodec(QTextCodec::codecForName("UTF-8"));
-        stream << "SOURCES += \\\n";
-        stream << sources.join("\\\n");
-        stream << "\n\nHEADERS += \\\n";
-        stream << headers.join("\\\n");
-        priFile.commit();
+    // runtime sources are built in both modes
+    QStringList runtimeSources;
+    for (const RuntimeFile& file: runtimeFiles()) {
+        if (file.name.endsWith(".cpp")) {
+            runtimeSources << ("$$PWD/" + file.name);
+            filenames.insert(QFileInfo(file.name).baseName());
+        }
+    }
+
+    // one registry over the types of every header, built in both modes as well
+    Code registry = RegistryEmitter::projectRegistry(registryIncludes, registryTypes);
+    if (!registry.decl.isEmpty()) {
+        writeFormatted(rootPath + "/api_registry.hpp", registry.decl);
+        writeFormatted(rootPath + "/api_registry.cpp", registry.impl);
+        headers << "$$PWD/api_registry.hpp";
+        runtimeSources << "$$PWD/api_registry.cpp";
+        filenames.insert("api_registry");
     }
-    QSaveFile proFile(rootPath + "/api-gen.pro");
-    if (proFile.open(QIODevice::WriteOnly)) {
-        QTextStream stream(&proFile);
-        stream.setCodec(QTextCodec::codecForName("UTF-8"));
-        stream <<
+    sources << runtimeSources;
+
+    // one source per directory including the others, qmake keeps objects in one directory so the names must be unique
+    QStringList unityFiles = runtimeSources;
+    for (auto it = unitySources.constBegin(); it != unitySources.constEnd(); ++it) {
+        QString filename = "gbp_unity" + QString(it.key()).replace('/', '_');
+        while (filenames.contains(filename)) {
+            filename += "_";
+        }
+        filenames.insert(filename);
+
+        QString content = "// unity source of the directory, built instead of the files it includes\n";
+        for (const QString& source: it.value()) {
+            content += "#include \"" + source + "\"\n";
+        }
+        unityFiles << ("$$PWD" + it.key() + "/" + filename + ".cpp");
+        m_impl->writeIfChanged(manifest, writer, rootPath + it.key() + "/" + filename + ".cpp", content);
+    }
+
+    m_impl->writeIfChanged(manifest, writer, rootPath + "/api-gen.pri", "gbp_unity {\n"
+                                                                      "SOURCES += \\\n"
+                                                                      + unityFiles.join("\\\n")
+                                                                      + "\n} else {\n"
+                                                                      "SOURCES += \\\n"
+                                                                      + sources.join("\\\n")
+                                                                      + "\n}\n\nHEADERS += \\\n"
+                                                                      + headers.join("\\\n"));
+    m_impl->writeIfChanged(manifest, writer, rootPath + "/api-gen.pro",
 R"(TEMPLATE = lib
 CONFIG += c++17
 CONFIG += staticlib
+# one source per directory and a precompiled declare_type.h, remove for per-file builds
+CONFIG += gbp_unity gbp_pch
 TARGET = gbp-api
 INCLUDEPATH += $$PWD/..
 DEFINES += GBP_DECLARE_TYPE_GEN_ADDITIONALS
-include($$PWD/api-gen.pri))";
-        proFile.commit();
-    }
-    QSaveFile batStyle(rootPath + "/api-gen-stylize.bat");
-    if (batStyle.open(QIODevice::WriteOnly)) {
-        QTextStream stream(&batStyle);
-        stream.setCodec(QTextCodec::codecForName("UTF-8"));
-        stream << consoleCommands.join("\n");
-        batStyle.commit();
-    }
-
-    system(QString("cd %0 && %1").arg(rootPath).arg("api-gen-stylize.bat").toLatin1());
-
-    QSaveFile declTypeFile(rootPath + "/declare_type.h");
-    if (declTypeFile.open(QIODevice::WriteOnly)) {
-        QTextStream stream(&declTypeFile);
-        stream.setCodec(QTextCodec::codecForName("UTF-8"));
-        stream <<
-R"(
-#ifndef _gbp__api__declare_type
-#define _gbp__api__declare_type
-#include "gbp_int.hpp"
-#include <api/declare_type/decorators.hpp>
-#include <api/declare_type/list.hpp>
-#include <api/declare_type/map.hpp>
-#include <api/declare_type/pair.hpp>
-#include <api/declare_type/quoting.hpp>
-#include <api/declare_type/set.hpp>
-#include <api/declare_type/tuple.hpp>
-#include <api/declare_type/unordered_map.hpp>
-#include <api/declare_type/unordered_multimap.hpp>
-#include <api/declare_type/unordered_set.hpp>
-#include <api/declare_type/vector.hpp>
-#include <sstream>
-#define GBP_DECLARE_TYPE(...)
-#define GBP_DECLARE_ENUM(...)
-#define GBP_DECLARE_ENUM_SIMPLE(...)
-template<typename T>
-struct is_gbp_type
-{
-private:
-    typedef char yes;
-    typedef short no;
-
-    template<typename C> static yes test(typename C::types_as_tuple*);
-    template<typename C> static no  test(...);
-public:
-    static const bool value = sizeof(test<T>(0)) == sizeof(yes);
-    typedef T type;
-};
-namespace _detail {
-    template <typename T, int N = 0>
-    struct apply_helper {
-        template <typename F>
-        static void apply(T* obj, F&& f) {
-            f(T::template member_name<N>(), obj->template get_member<N>());
-            apply_helper<T, N + 1>::apply(obj, std::move(f));
-        }
-        template <typename F>
-        static void apply(const T* obj, F&& f) {
-            f(T::template member_name<N>(), obj->template get_member<N>());
-            apply_helper<T, N + 1>::apply(obj, std::move(f));
-        }
-    };
-
-    template <typename T>
-    struct apply_helper<T, std::tuple_size<typename T::types_as_tuple>::value - 1> {
-        static const int N = std::tuple_size<typename T::types_as_tuple>::value - 1;
-
-        template <typename F>
-        static void apply(T* obj, F&& f) {
-            f(T::template member_name<N>(), obj->template get_member<N>());
-        }
-        template <typename F>
-        static void apply(const T* obj, F&& f) {
-            f(T::template member_name<N>(), obj->template get_member<N>());
-        }
-    };
-
-    template <typename T, int N = 0>
-    struct cmp_helper {
-        template <typename F>
-        static bool cmp(T* obj1, const T* obj2, F&& f) {
-            if (obj1->template get_member<N>() != obj2->template get_member<N>()) {
-                f(T::template member_name<N>(), obj1->template get_member<N>(), obj2->template get_member<N>());
-                cmp_helper<T, N + 1>::cmp(obj1, obj2, std::move(f));
-                return true;
-            }
-            return cmp_helper<T, N + 1>::cmp(obj1, obj2, std::move(f));
-        }
-        template <typename F>
-        static bool cmp(const T* obj1, const T* obj2, F&& f) {
-            if (obj1->template get_member<N>() != obj2->template get_member<N>()) {
-                f(T::template member_name<N>(), obj1->template get_member<N>(), obj2->template get_member<N>());
-                cmp_helper<T, N + 1>::cmp(obj1, obj2, std::move(f));
-                return true;
-            }
-            return cmp_helper<T, N + 1>::cmp(obj1, obj2, std::move(f));
-        }
-    };
+gbp_pch {
+    CONFIG += precompile_header
+    PRECOMPILED_HEADER = $$PWD/gbp_pch.h
+}
+include($$PWD/api-gen.pri))");
 
-    template <typename T>
-    struct cmp_helper<T, std::tuple_size<typename T::types_as_tuple>::value - 1> {
-        static const int N = std::tuple_size<typename T::types_as_tuple>::value - 1;
+    for (const RuntimeFile& file: runtimeFiles()) {
+        m_impl->writeIfChanged(manifest, writer, rootPath + "/" + file.name, file.content);
+    }
 
-        template <typename F>
-        static bool cmp(T* obj1, const T* obj2, F&& f) {
-            if (obj1->template get_member<N>() != obj2->template get_member<N>()) {
-                f(T::template member_name<N>(), obj1->template get_member<N>(), obj2->template get_member<N>());
-                return true;
-            }
-            return false;
-        }
-        template <typename F>
-        static bool cmp(const T* obj1, const T* obj2, F&& f) {
-            if (obj1->template get_member<N>() != obj2->template get_member<N>()) {
-                f(T::template member_name<N>(), obj1->template get_member<N>(), obj2->template get_member<N>());
-                return true;
+    formatter.wait();
+    // the manifest only holds what is on disk now, failed files are written again next time
+    OutputWriter::Stats stats = writer.finish();
+
+    // only pages open in this session were generated, the outputs of the other headers stay until the header is gone
+    int removed = manifest.removeStale([&generatedSources](const QString& output) {
+        static const QRegularExpression renamedRe("_\\d+$");
+        QFileInfo info(output);
+        QString dir = info.absolutePath().replace("/api-gen", "/api");
+        QStringList baseNames = QStringList() << info.completeBaseName() << info.completeBaseName().remove(renamedRe);
+        for (const QString& baseName: baseNames) {
+            for (const QString& suffix: QStringList() << "h" << "hpp") {
+                QString source = dir + "/" + baseName + "." + suffix;
+                if (QFileInfo::exists(source)) {
+                    return generatedSources.contains(QFileInfo(source).absoluteFilePath());
+                }
             }
-            return false;
         }
-    };
-} //namespace _detail
-
-namespace gbp {
-    template <typename T, typename F>
-    void invoke_apply(T* obj, F&& f) {
-        _detail::apply_helper<T>::apply(obj, std::move(f));
-    }
-    template <typename T, typename F>
-    void invoke_apply(const T* obj, F&& f) {
-        _detail::apply_helper<T>::apply(obj, std::move(f));
-    }
-
-    template <typename T, typename F>
-    bool invoke_cmp(T* obj1, const T* obj2, F&& f) {
-        return _detail::cmp_helper<T>::cmp(obj1, obj2, std::move(f));
-    }
-    template <typename T, typename F>
-    bool invoke_cmp(const T* obj1, const T* obj2, F&& f) {
-        return _detail::cmp_helper<T>::cmp(obj1, obj2, std::move(f));
-    }
-} //namespace gbp
-#endif)";
-        declTypeFile.commit();
-    }
-
-    QSaveFile gbp_intFile(rootPath + "/gbp_int.hpp");
-    if (gbp_intFile.open(QIODevice::WriteOnly)) {
-        QTextStream stream(&gbp_intFile);
-        stream.setCodec(QTextCodec::codecForName("UTF-8"));
-        stream <<
-R"(#pragma once
-
-using gbp_i64 = long long int;
-using gbp_u64 = unsigned long long int;
-using gbp_i32 = int;
-using gbp_u32 = unsigned int;
-using gbp_i16 = short;
-using gbp_u16 = unsigned short;
-using gbp_i8  = signed char;
-using gbp_u8  = unsigned char;)";
-        gbp_intFile.commit();
+        return true;
+    });
+    if (removed > 0) {
+        qDebug() << "removed" << removed << "stale generated files";
     }
+    manifest.save();
+    // generators before SourceFormatter formatted through this batch file
+    QFile::remove(rootPath + "/api-gen-stylize.bat");
+
+    qDebug() << "formatted" << formatter.formattedCount() << "files"
+             << (formatter.failedCount() > 0 ? QString("(%0 failed)").arg(formatter.failedCount()) : QString());
+    qDebug() << "written" << stats.files << "files," << stats.bytes << "bytes in" << stats.elapsedMs << "ms"
+             << (stats.failed > 0 ? QString("(%0 failed)").arg(stats.failed) : QString());
 }
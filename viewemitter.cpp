@@ -0,0 +1,56 @@
+#include "viewemitter.hpp"
+#include "codecemitter.hpp"
+
+/**
+ %0 - struct name, qualified with the enclosing structs
+ %1 - struct name
+ %2 - member accessors
+ %9 - friend if needed
+ */
+constexpr static const char* codeTmpView =
+R"code(class %1View
+{
+    gbp::byte_span m_data;
+    std::array<std::size_t, %0::member_count + 1> m_offsets;
+    bool m_valid;
+
+    // member types are named in the scope of the struct, they may be nested in it
+    template <int N> using member_type = typename std::tuple_element<N, %0::types_as_tuple>::type;
+    template <int N> inline gbp::byte_span member() const { return gbp::byte_span(m_data.data + m_offsets[N], m_offsets[N + 1] - m_offsets[N]); }
+public:
+    %1View() : m_data(), m_offsets(), m_valid(false) {}
+    /** validates the encoded object and records where each member starts */
+    explicit %1View(gbp::byte_span data)
+        : m_data(data)
+        , m_offsets()
+        , m_valid(gbp::scan_members<%1>(m_data, m_offsets))
+    {}
+
+    inline bool valid() const { return m_valid; }
+    inline gbp::byte_span bytes() const { return m_data; }
+    inline bool decode(%1& obj) const { return m_valid && obj.decode(m_data); }
+
+    %2
+};
+// only named in decltype by gbp::view_traits
+%9%1View gbp_view_type(const %1&);
+)code";
+
+QString ViewEmitter::name() const {
+    return "view";
+}
+
+void ViewEmitter::emitStruct(const TypeDescriptor& type, TypeCode& code)
+{
+    QStringList accessors;
+
+    for (int i = 0; i < type.members.size(); i++) {
+        const MemberDescriptor& member = type.members.at(i);
+        QString wire = CodecEmitter::wireType(member);
+        QString viewArgs = QString("member_type<%0>").arg(i) + (wire.isEmpty() ? QString() : ", " + wire);
+        accessors << QString("inline gbp::view_t<%1> %0() const { return gbp::make_view<%1>(member<%2>()); }").arg(member.name).arg(viewArgs).arg(i);
+    }
+
+    // no nested class, it could collide with a member
+    code.related += additionalsOnly(QString(codeTmpView).arg(type.fullName).arg(type.name).arg(accessors.join("\n")).arg(type.friendPrefix()));
+}
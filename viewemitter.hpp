@@ -0,0 +1,16 @@
+#pragma once
+
+#include "emitter.hpp"
+
+/**
+ Read-only views over the binary encoding (gbp_view.hpp).
+ Every struct gets a class <Type>View next to it, found by gbp::view_traits through gbp_view_type(),
+ with one accessor per member reading straight from the encoded bytes.
+ */
+class ViewEmitter : public Emitter
+{
+public:
+    virtual QString name() const override;
+
+    virtual void emitStruct(const TypeDescriptor& type, TypeCode& code) override;
+};